@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+
+#include <cpplibxml2.hpp>
+
+#include <string>
+
+#ifdef CPPLIBXML2_ENABLE_ARENA
+
+namespace
+{
+std::string makeRequest(const std::size_t records)
+{
+    std::string xml = R"(<?xml version="1.0"?><request>)";
+    for (std::size_t i = 0; i < records; ++i)
+        xml += R"(<item id=")" + std::to_string(i) + R"(" kind="standard"><name>item )" + std::to_string(i) +
+               "</name><qty>3</qty><price>9.95</price></item>";
+    xml += "</request>";
+    return xml;
+}
+
+// Each iteration parses and destroys one document, i.e. the whole lifetime of a request-scoped document.
+
+void BM_ParseAndFree(benchmark::State &state)
+{
+    const auto xml = makeRequest(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        auto doc = cpplibxml2::Doc::parse(xml);
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(xml.size()));
+}
+BENCHMARK(BM_ParseAndFree)->Range(8, 8 << 10);
+
+void BM_ParseAndFreeInArena(benchmark::State &state)
+{
+    const auto xml = makeRequest(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        auto doc = cpplibxml2::Doc::parseInArena(xml);
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(xml.size()));
+}
+BENCHMARK(BM_ParseAndFreeInArena)->Range(8, 8 << 10);
+} // namespace
+
+#endif
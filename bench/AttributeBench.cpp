@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include <cpplibxml2.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+std::string makeWideElement(const std::size_t attributes)
+{
+    std::string xml = R"(<?xml version="1.0"?><record)";
+    for (std::size_t i = 0; i < attributes; ++i)
+        xml += " attribute" + std::to_string(i) + "=\"" + std::to_string(i) + "\"";
+    xml += "/>";
+    return xml;
+}
+
+std::vector<std::string> attributeNames(const std::size_t attributes)
+{
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < attributes; ++i)
+        names.push_back("attribute" + std::to_string(i));
+    return names;
+}
+
+// Each iteration looks up every attribute of the element once.
+
+void BM_AttributeFindProperty(benchmark::State &state)
+{
+    const auto attributes = static_cast<std::size_t>(state.range(0));
+    const auto doc = cpplibxml2::Doc::parse(makeWideElement(attributes));
+    const auto record = doc.value().root().value();
+    const auto names = attributeNames(attributes);
+    for (auto _ : state)
+    {
+        for (const auto &name : names)
+        {
+            auto value = record.findProperty(name);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AttributeFindProperty)->RangeMultiplier(2)->Range(2, 64);
+
+void BM_AttributeLinear(benchmark::State &state)
+{
+    const auto attributes = static_cast<std::size_t>(state.range(0));
+    const auto doc = cpplibxml2::Doc::parse(makeWideElement(attributes));
+    const auto record = doc.value().root().value();
+    const auto names = attributeNames(attributes);
+    for (auto _ : state)
+    {
+        for (const auto &name : names)
+        {
+            auto value = record.attribute(name);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AttributeLinear)->RangeMultiplier(2)->Range(2, 64);
+
+void BM_AttributeIndexLookup(benchmark::State &state)
+{
+    const auto attributes = static_cast<std::size_t>(state.range(0));
+    const auto doc = cpplibxml2::Doc::parse(makeWideElement(attributes));
+    const cpplibxml2::AttributeIndex index{doc.value().root().value()};
+    const auto names = attributeNames(attributes);
+    for (auto _ : state)
+    {
+        for (const auto &name : names)
+        {
+            auto value = index.find(name);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AttributeIndexLookup)->RangeMultiplier(2)->Range(2, 64);
+
+void BM_AttributeIndexBuildAndLookup(benchmark::State &state)
+{
+    const auto attributes = static_cast<std::size_t>(state.range(0));
+    const auto doc = cpplibxml2::Doc::parse(makeWideElement(attributes));
+    const auto record = doc.value().root().value();
+    const auto names = attributeNames(attributes);
+    for (auto _ : state)
+    {
+        const cpplibxml2::AttributeIndex index{record};
+        for (const auto &name : names)
+        {
+            auto value = index.find(name);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AttributeIndexBuildAndLookup)->RangeMultiplier(2)->Range(2, 64);
+} // namespace
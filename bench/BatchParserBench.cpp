@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <batchParser.hpp>
+
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t fileCount = 256;
+
+/**
+ * Writes fileCount documents of about 32 KB each to the temp directory once.
+ */
+const std::vector<std::filesystem::path> &corpus()
+{
+    static const auto paths = [] {
+        const auto directory = std::filesystem::temp_directory_path() / "cpplibxml2_bench_batch";
+        std::filesystem::create_directories(directory);
+        std::vector<std::filesystem::path> result;
+        for (std::size_t i = 0; i < fileCount; ++i)
+        {
+            auto path = directory / ("doc" + std::to_string(i) + ".xml");
+            if (!std::filesystem::exists(path))
+            {
+                std::ofstream out{path, std::ios::binary};
+                out << R"(<?xml version="1.0"?><orders>)";
+                for (std::size_t line = 0; line < 300; ++line)
+                    out << "<order id=\"" << line << "\"><sku>SKU-" << i << "-" << line
+                        << "</sku><amount>12.50</amount><note>standard delivery</note></order>";
+                out << "</orders>";
+            }
+            result.push_back(std::move(path));
+        }
+        return result;
+    }();
+    return paths;
+}
+
+void BM_SerialParseFile(benchmark::State &state)
+{
+    const auto &paths = corpus();
+    for (auto _ : state)
+    {
+        for (const auto &path : paths)
+        {
+            auto doc = cpplibxml2::Doc::parseFile(path);
+            benchmark::DoNotOptimize(doc);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(paths.size()));
+}
+BENCHMARK(BM_SerialParseFile)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+void BM_BatchParseFiles(benchmark::State &state)
+{
+    const auto &paths = corpus();
+    cpplibxml2::BatchParser batch{static_cast<std::size_t>(state.range(0))};
+    for (auto _ : state)
+    {
+        auto docs = batch.parseFiles(paths);
+        benchmark::DoNotOptimize(docs);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(paths.size()));
+}
+BENCHMARK(BM_BatchParseFiles)
+    ->RangeMultiplier(2)
+    ->Range(1, std::max(1u, std::thread::hardware_concurrency()))
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+} // namespace
@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+
+#include <cpplibxml2.hpp>
+
+#include <array>
+#include <string>
+
+namespace
+{
+// Three fields per record; the root is not counted.
+constexpr std::int64_t nodesPerRecord = 7;
+
+void BM_BuildAddValue(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        const auto doc = cpplibxml2::Doc::parse(R"(<?xml version="1.0"?><export/>)").value();
+        const auto root = doc.root().value();
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+        {
+            const auto record = root.addChild("record").value();
+            record.addChild("id").value().addValue(std::to_string(i));
+            record.addChild("name").value().addValue("record name");
+            record.addChild("amount").value().addValue(std::to_string(i * 3));
+        }
+        benchmark::DoNotOptimize(root);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * nodesPerRecord);
+}
+BENCHMARK(BM_BuildAddValue)->Arg(1 << 10)->Arg(1 << 17);
+
+void BM_BuildCreate(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        auto doc = cpplibxml2::Doc::create("export").value();
+        const auto root = doc.root().value();
+        const auto record = doc.intern("record");
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+        {
+            const auto id = std::to_string(i);
+            const auto amount = std::to_string(i * 3);
+            const std::array<std::pair<std::string_view, std::string_view>, 3> fields{
+                {{"id", id}, {"name", "record name"}, {"amount", amount}}};
+            (void)root.addChild(record).value().addChildren(fields);
+        }
+        benchmark::DoNotOptimize(root);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * nodesPerRecord);
+}
+BENCHMARK(BM_BuildCreate)->Arg(1 << 10)->Arg(1 << 17);
+} // namespace
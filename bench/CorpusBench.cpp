@@ -0,0 +1,195 @@
+#include <benchmark/benchmark.h>
+
+#include "corpus.hpp"
+
+#include <cpplibxml2.hpp>
+#include <libxml/xmlversion.h>
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+
+// Registers every operation for every corpus shape and size as Corpus<Operation>/<shape>/<size>kb, e.g.
+// CorpusParse/namespaces/1024kb. Byte rates refer to the size of the serialized corpus, item rates to elements.
+
+namespace
+{
+using corpus::Shape;
+
+cpplibxml2::Doc parseCorpus(const Shape shape, const std::size_t kib)
+{
+    return cpplibxml2::Doc::parse(corpus::get(shape, kib)).value();
+}
+
+void setBytes(benchmark::State &state, const Shape shape, const std::size_t kib)
+{
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(corpus::get(shape, kib).size()));
+}
+
+/**
+ * Depth-first walk over all elements through getChildren(), as user code without the range views would do it.
+ */
+void walk(const cpplibxml2::Node &node, const std::function<void(const cpplibxml2::Node &)> &visit)
+{
+    visit(node);
+    const auto children = node.getChildren();
+    for (const auto &child : children.value())
+        walk(child, visit);
+}
+
+void parse(benchmark::State &state, const Shape shape, const std::size_t kib)
+{
+    const auto &xml = corpus::get(shape, kib);
+    for (auto _ : state)
+    {
+        auto doc = cpplibxml2::Doc::parse(xml);
+        benchmark::DoNotOptimize(doc);
+    }
+    setBytes(state, shape, kib);
+}
+
+void parseFile(benchmark::State &state, const Shape shape, const std::size_t kib)
+{
+    const auto path = std::filesystem::temp_directory_path() /
+                      std::string{"cpplibxml2_corpus_"}.append(corpus::name(shape)).append(std::to_string(kib));
+    {
+        const auto &xml = corpus::get(shape, kib);
+        std::ofstream out{path, std::ios::binary};
+        out.write(xml.data(), static_cast<std::streamsize>(xml.size()));
+    }
+    for (auto _ : state)
+    {
+        auto doc = cpplibxml2::Doc::parseFile(path);
+        benchmark::DoNotOptimize(doc);
+    }
+    setBytes(state, shape, kib);
+    std::filesystem::remove(path);
+}
+
+void findChild(benchmark::State &state, const Shape shape, const std::size_t kib)
+{
+    const auto doc = parseCorpus(shape, kib);
+    const auto root = doc.root().value();
+    const auto probe = corpus::probe(shape);
+    std::int64_t elements = 0;
+    for (auto _ : state)
+    {
+        walk(root, [&](const cpplibxml2::Node &node) {
+            auto found = node.findChild(probe);
+            benchmark::DoNotOptimize(found);
+            ++elements;
+        });
+    }
+    state.SetItemsProcessed(elements);
+}
+
+void getChildren(benchmark::State &state, const Shape shape, const std::size_t kib)
+{
+    const auto doc = parseCorpus(shape, kib);
+    const auto root = doc.root().value();
+    std::int64_t elements = 0;
+    for (auto _ : state)
+    {
+        walk(root, [&elements](const cpplibxml2::Node &) { ++elements; });
+    }
+    state.SetItemsProcessed(elements);
+}
+
+void value(benchmark::State &state, const Shape shape, const std::size_t kib)
+{
+    const auto doc = parseCorpus(shape, kib);
+    const auto root = doc.root().value();
+    std::int64_t elements = 0;
+    for (auto _ : state)
+    {
+        walk(root, [&elements](const cpplibxml2::Node &node) {
+            auto text = node.value();
+            benchmark::DoNotOptimize(text);
+            ++elements;
+        });
+    }
+    state.SetItemsProcessed(elements);
+}
+
+void valueView(benchmark::State &state, const Shape shape, const std::size_t kib)
+{
+    const auto doc = parseCorpus(shape, kib);
+    const auto root = doc.root().value();
+    std::string buffer;
+    std::int64_t elements = 0;
+    for (auto _ : state)
+    {
+        walk(root, [&](const cpplibxml2::Node &node) {
+            auto text = node.valueView(buffer);
+            benchmark::DoNotOptimize(text);
+            ++elements;
+        });
+    }
+    state.SetItemsProcessed(elements);
+}
+
+void getProperties(benchmark::State &state, const Shape shape, const std::size_t kib)
+{
+    const auto doc = parseCorpus(shape, kib);
+    const auto root = doc.root().value();
+    std::int64_t elements = 0;
+    for (auto _ : state)
+    {
+        walk(root, [&elements](const cpplibxml2::Node &node) {
+            auto properties = node.getProperties();
+            benchmark::DoNotOptimize(properties);
+            ++elements;
+        });
+    }
+    state.SetItemsProcessed(elements);
+}
+
+void dump(benchmark::State &state, const Shape shape, const std::size_t kib)
+{
+    const auto doc = parseCorpus(shape, kib);
+    for (auto _ : state)
+    {
+        auto out = doc.dump();
+        benchmark::DoNotOptimize(out);
+    }
+    setBytes(state, shape, kib);
+}
+
+using Operation = void (*)(benchmark::State &, Shape, std::size_t);
+
+constexpr std::pair<std::string_view, Operation> operations[]{
+    {"CorpusParse", parse},
+    {"CorpusParseFile", parseFile},
+    {"CorpusFindChild", findChild},
+    {"CorpusGetChildren", getChildren},
+    {"CorpusValue", value},
+    {"CorpusValueView", valueView},
+    {"CorpusGetProperties", getProperties},
+    {"CorpusDump", dump},
+};
+
+[[maybe_unused]] const int registered = [] {
+    benchmark::AddCustomContext("cpplibxml2_version", CPPLIBXML2_VERSION);
+    benchmark::AddCustomContext("libxml2_version", LIBXML_DOTTED_VERSION);
+
+    for (const auto &[operation, function] : operations)
+    {
+        for (const auto shape : corpus::shapes)
+        {
+            for (const auto kib : corpus::sizes)
+            {
+                const auto benchmarkName = std::string{operation}
+                                               .append("/")
+                                               .append(corpus::name(shape))
+                                               .append("/")
+                                               .append(std::to_string(kib))
+                                               .append("kb");
+                benchmark::RegisterBenchmark(benchmarkName.c_str(), function, shape, kib)
+                    ->Unit(benchmark::kMicrosecond);
+            }
+        }
+    }
+    return 0;
+}();
+} // namespace
@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+
+#include <cpplibxml2.hpp>
+
+#include <cstdlib>
+#include <istream>
+#include <string>
+#include <utility>
+
+// Parsing inputs of several hundred MiB, and beyond 2 GiB with CPPLIBXML2_LARGE_BENCH set. Records are padded with
+// whitespace inside the tag, which the parser drops, so the tree stays small enough for multi-GiB inputs.
+
+namespace
+{
+constexpr auto options = cpplibxml2::ParserOptions::NoBlanks;
+
+void appendRecord(std::string &xml, const std::size_t i)
+{
+    xml.append("<record id=\"").append(std::to_string(i)).append("\"");
+    xml.append(4000, ' ').append("/>\n");
+}
+
+/**
+ * Produces a document of at least `size` bytes on the fly, for parsing inputs that are never held in memory.
+ */
+class GeneratingBuffer : public std::streambuf
+{
+    std::size_t size;
+    std::size_t produced = 0;
+    std::size_t records = 0;
+    std::string chunk;
+    bool closed = false;
+
+  public:
+    explicit GeneratingBuffer(const std::size_t total) : size(total)
+    {
+    }
+
+  protected:
+    int_type underflow() override
+    {
+        if (this->closed)
+            return traits_type::eof();
+
+        this->chunk.clear();
+        if (this->produced == 0)
+            this->chunk.append("<records>");
+        while (this->chunk.size() < 65536 && this->produced + this->chunk.size() < this->size)
+            appendRecord(this->chunk, this->records++);
+        if (this->produced + this->chunk.size() >= this->size)
+        {
+            this->chunk.append("</records>");
+            this->closed = true;
+        }
+        this->produced += this->chunk.size();
+        this->setg(this->chunk.data(), this->chunk.data(), this->chunk.data() + this->chunk.size());
+        return traits_type::to_int_type(this->chunk.front());
+    }
+};
+
+std::size_t toBytes(const std::int64_t mib)
+{
+    return static_cast<std::size_t>(mib) << 20;
+}
+
+// Below 2 GiB this is libxml2's in-place memory parser, beyond it the chunked read callback.
+void BM_LargeParseMemory(benchmark::State &state)
+{
+    std::string xml = "<records>";
+    xml.reserve(toBytes(state.range(0)) + 8192);
+    for (std::size_t i = 0; xml.size() < toBytes(state.range(0)); ++i)
+        appendRecord(xml, i);
+    xml.append("</records>");
+
+    for (auto _ : state)
+    {
+        auto doc = cpplibxml2::Doc::parse(xml, options);
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(xml.size()));
+}
+
+void BM_LargeParseStream(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        GeneratingBuffer buffer{toBytes(state.range(0))};
+        auto input = std::istream{&buffer};
+        state.ResumeTiming();
+
+        auto doc = cpplibxml2::Doc::parse(input, options);
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(toBytes(state.range(0))));
+}
+
+using Operation = void (*)(benchmark::State &);
+
+constexpr std::pair<const char *, Operation> operations[]{
+    {"BM_LargeParseMemory", BM_LargeParseMemory},
+    {"BM_LargeParseStream", BM_LargeParseStream},
+};
+
+[[maybe_unused]] const int registered = [] {
+    for (const auto &[name, function] : operations)
+    {
+        benchmark::RegisterBenchmark(name, function)->Arg(256)->Unit(benchmark::kMillisecond);
+        // One iteration of a 3 GiB parse takes seconds already.
+        if (std::getenv("CPPLIBXML2_LARGE_BENCH") != nullptr)
+            benchmark::RegisterBenchmark(name, function)->Arg(3072)->Iterations(1)->Unit(benchmark::kMillisecond);
+    }
+    return 0;
+}();
+} // namespace
@@ -0,0 +1,179 @@
+#include <benchmark/benchmark.h>
+
+#include <cpplibxml2.hpp>
+
+#include <ranges>
+#include <string>
+
+namespace
+{
+std::string makeWideDocument(const std::size_t children)
+{
+    std::string xml = R"(<?xml version="1.0"?><root>)";
+    for (std::size_t i = 0; i < children; ++i)
+        xml += "<item><name>item" + std::to_string(i) + "</name><price>" + std::to_string(i) + ".5</price></item>";
+    xml += "</root>";
+    return xml;
+}
+
+std::size_t countElements(const cpplibxml2::Node &node)
+{
+    std::size_t count = 1;
+    if (const auto children = node.getChildren())
+    {
+        for (const auto &child : children.value())
+            count += countElements(child);
+    }
+    return count;
+}
+
+void BM_RootHandle(benchmark::State &state)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeWideDocument(1));
+    for (auto _ : state)
+    {
+        auto root = doc.value().root();
+        benchmark::DoNotOptimize(root);
+    }
+}
+BENCHMARK(BM_RootHandle);
+
+void BM_GetChildren(benchmark::State &state)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeWideDocument(static_cast<std::size_t>(state.range(0))));
+    const auto root = doc.value().root();
+    for (auto _ : state)
+    {
+        auto children = root.value().getChildren();
+        benchmark::DoNotOptimize(children);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GetChildren)->Range(8, 8 << 10);
+
+void BM_FindChildPerRecord(benchmark::State &state)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeWideDocument(static_cast<std::size_t>(state.range(0))));
+    const auto root = doc.value().root();
+    for (auto _ : state)
+    {
+        const auto items = root.value().getChildren();
+        for (const auto &item : items.value())
+        {
+            auto price = item.findChild("price");
+            benchmark::DoNotOptimize(price);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FindChildPerRecord)->Range(8, 8 << 10);
+
+void BM_FindChildPerRecordKey(benchmark::State &state)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeWideDocument(static_cast<std::size_t>(state.range(0))));
+    const auto root = doc.value().root();
+    const auto price = doc.value().nameKey("price");
+    for (auto _ : state)
+    {
+        for (const auto item : root.value().elements())
+        {
+            auto found = item.findChild(price);
+            benchmark::DoNotOptimize(found);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FindChildPerRecordKey)->Range(8, 8 << 10);
+
+// Looks up a name none of the N siblings has, so every sibling is compared.
+void BM_FindLastSibling(benchmark::State &state)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeWideDocument(static_cast<std::size_t>(state.range(0))));
+    const auto root = doc.value().root();
+    for (auto _ : state)
+    {
+        auto found = root.value().findChild("missing");
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FindLastSibling)->Range(8, 8 << 10);
+
+void BM_FindLastSiblingKey(benchmark::State &state)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeWideDocument(static_cast<std::size_t>(state.range(0))));
+    const auto root = doc.value().root();
+    const auto missing = doc.value().nameKey("missing");
+    for (auto _ : state)
+    {
+        auto found = root.value().findChild(missing);
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FindLastSiblingKey)->Range(8, 8 << 10);
+
+void BM_RecursiveTraversal(benchmark::State &state)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeWideDocument(static_cast<std::size_t>(state.range(0))));
+    const auto root = doc.value().root();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(countElements(root.value()));
+    state.SetItemsProcessed(state.iterations() * (state.range(0) * 3 + 1));
+}
+BENCHMARK(BM_RecursiveTraversal)->Range(8, 8 << 10);
+
+void BM_ElementsRange(benchmark::State &state)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeWideDocument(static_cast<std::size_t>(state.range(0))));
+    const auto root = doc.value().root();
+    for (auto _ : state)
+    {
+        for (const auto child : root.value().elements())
+            benchmark::DoNotOptimize(child);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ElementsRange)->Range(8, 8 << 10);
+
+void BM_DescendantsRange(benchmark::State &state)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeWideDocument(static_cast<std::size_t>(state.range(0))));
+    const auto root = doc.value().root();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(std::ranges::distance(root.value().descendants()));
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 3);
+}
+BENCHMARK(BM_DescendantsRange)->Range(8, 8 << 10);
+void BM_ValueCopy(benchmark::State &state)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeWideDocument(static_cast<std::size_t>(state.range(0))));
+    const auto root = doc.value().root();
+    for (auto _ : state)
+    {
+        for (const auto item : root.value().elements())
+        {
+            auto value = item.findChild("price").value().value();
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ValueCopy)->Range(8, 8 << 10);
+
+void BM_ValueView(benchmark::State &state)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeWideDocument(static_cast<std::size_t>(state.range(0))));
+    const auto root = doc.value().root();
+    for (auto _ : state)
+    {
+        for (const auto item : root.value().elements())
+        {
+            auto value = item.findChild("price").value().valueView();
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ValueView)->Range(8, 8 << 10);
+} // namespace
@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+
+#include "corpus.hpp"
+
+#include <parallelParser.hpp>
+
+// Parsing one large feed serially against cutting it into chunks parsed on several threads and stitched together.
+
+namespace
+{
+const std::string &feed()
+{
+    return corpus::get(corpus::Shape::Wide, 8192);
+}
+
+void BM_FeedSerial(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        auto doc = cpplibxml2::Doc::parse(feed());
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(feed().size()));
+}
+BENCHMARK(BM_FeedSerial)->Unit(benchmark::kMillisecond);
+
+void BM_FeedParallel(benchmark::State &state)
+{
+    const cpplibxml2::ParallelParser parser{static_cast<std::size_t>(state.range(0))};
+    for (auto _ : state)
+    {
+        auto doc = parser.parse(feed(), "item");
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(feed().size()));
+}
+BENCHMARK(BM_FeedParallel)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+} // namespace
@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+
+#include <cpplibxml2.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+/**
+ * Writes a catalog-like document of roughly the requested size to the temp directory once per size.
+ */
+std::filesystem::path generatedFile(const std::size_t megabytes)
+{
+    const auto path =
+        std::filesystem::temp_directory_path() / ("cpplibxml2_bench_" + std::to_string(megabytes) + "mb.xml");
+    if (std::filesystem::exists(path))
+        return path;
+
+    std::ofstream out{path, std::ios::binary};
+    out << R"(<?xml version="1.0"?>)" << "\n<catalog>\n";
+    const std::size_t target = megabytes << 20;
+    std::size_t written = 0;
+    for (std::size_t i = 0; written < target; ++i)
+    {
+        const auto record = "  <book id=\"bk" + std::to_string(i) + "\"><author>Author " + std::to_string(i) +
+                            "</author><title>Title</title><price>" + std::to_string(i % 100) +
+                            ".95</price><description>Lorem ipsum dolor sit amet, consectetur adipiscing "
+                            "elit.</description></book>\n";
+        out << record;
+        written += record.size();
+    }
+    out << "</catalog>\n";
+    return path;
+}
+
+void BM_ParseFile(benchmark::State &state)
+{
+    const auto path = generatedFile(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        auto doc = cpplibxml2::Doc::parseFile(path);
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(std::filesystem::file_size(path)));
+}
+BENCHMARK(BM_ParseFile)->Arg(1)->Arg(16)->Arg(128)->Unit(benchmark::kMillisecond);
+
+void BM_ParseMappedFile(benchmark::State &state)
+{
+    const auto path = generatedFile(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        auto doc = cpplibxml2::Doc::parseMappedFile(path);
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(std::filesystem::file_size(path)));
+}
+BENCHMARK(BM_ParseMappedFile)->Arg(1)->Arg(16)->Arg(128)->Unit(benchmark::kMillisecond);
+} // namespace
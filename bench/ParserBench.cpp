@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include <parser.hpp>
+
+#include <string>
+
+namespace
+{
+std::string makeMessage(const std::size_t fields)
+{
+    std::string xml = R"(<?xml version="1.0"?><message id="42">)";
+    for (std::size_t i = 0; i < fields; ++i)
+        xml += "<field" + std::to_string(i) + ">value</field" + std::to_string(i) + ">";
+    xml += "</message>";
+    return xml;
+}
+
+void BM_DocParseSmall(benchmark::State &state)
+{
+    const auto input = makeMessage(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        auto doc = cpplibxml2::Doc::parse(input);
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(input.size()));
+}
+BENCHMARK(BM_DocParseSmall)->Arg(1)->Arg(8)->Arg(64);
+
+void BM_ParserReuseSmall(benchmark::State &state)
+{
+    const auto input = makeMessage(static_cast<std::size_t>(state.range(0)));
+    cpplibxml2::Parser parser;
+    for (auto _ : state)
+    {
+        auto doc = parser.parse(input);
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(input.size()));
+}
+BENCHMARK(BM_ParserReuseSmall)->Arg(1)->Arg(8)->Arg(64);
+
+void BM_ParserLocalSmall(benchmark::State &state)
+{
+    const auto input = makeMessage(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        auto doc = cpplibxml2::Parser::local().parse(input);
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(input.size()));
+}
+BENCHMARK(BM_ParserLocalSmall)->Arg(1)->Arg(8)->Arg(64);
+} // namespace
@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include "corpus.hpp"
+
+#include <projection.hpp>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+// Parsing the 8 MiB corpora into a full Doc against a projection onto one field per record. The heap_bytes counter
+// is the heap memory the resulting Doc holds, where the C library can report it.
+
+namespace
+{
+using corpus::Shape;
+
+constexpr std::size_t kib = 8192;
+
+double heapInUse()
+{
+#if defined(__GLIBC__)
+    const auto info = mallinfo2();
+    return static_cast<double>(info.uordblks + info.hblkhd);
+#else
+    return 0;
+#endif
+}
+
+template <typename Parse>
+void measure(benchmark::State &state, const std::string &xml, Parse parse)
+{
+    for (auto _ : state)
+    {
+        auto doc = parse(xml);
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(xml.size()));
+
+    const auto before = heapInUse();
+    const auto doc = parse(xml);
+    state.counters["heap_bytes"] = heapInUse() - before;
+}
+
+void full(benchmark::State &state, const Shape shape)
+{
+    measure(state, corpus::get(shape, kib), [](const std::string &xml) { return cpplibxml2::Doc::parse(xml); });
+}
+
+void projected(benchmark::State &state, const Shape shape, const std::string_view path)
+{
+    const auto projection = cpplibxml2::Projection::create({path}).value();
+    measure(state, corpus::get(shape, kib), [&projection](const std::string &xml) { return projection.parse(xml); });
+}
+
+[[maybe_unused]] const int registered = [] {
+    constexpr std::pair<Shape, std::string_view> projections[]{
+        {Shape::Wide, "corpus/item/price"},
+        {Shape::TextHeavy, "corpus/section/title"},
+        {Shape::NamespaceHeavy, "ConnectorServices/Service/Abstract"},
+    };
+    for (const auto &[shape, path] : projections)
+    {
+        const auto suffix = std::string{"/"}.append(corpus::name(shape));
+        benchmark::RegisterBenchmark(std::string{"BM_ProjectionFull"}.append(suffix).c_str(), full, shape)
+            ->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark(std::string{"BM_ProjectionProjected"}.append(suffix).c_str(), projected, shape,
+                                     path)
+            ->Unit(benchmark::kMillisecond);
+    }
+    return 0;
+}();
+} // namespace
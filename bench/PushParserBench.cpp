@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+
+#include <pushParser.hpp>
+
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+const std::string &exampleInput()
+{
+    static const std::string input = [] {
+        std::ifstream in{"testData/example.xml", std::ios::binary};
+        std::ostringstream content;
+        content << in.rdbuf();
+        return content.str();
+    }();
+    return input;
+}
+
+void BM_DocParse(benchmark::State &state)
+{
+    const auto &input = exampleInput();
+    for (auto _ : state)
+    {
+        auto doc = cpplibxml2::Doc::parse(input);
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(input.size()));
+}
+BENCHMARK(BM_DocParse);
+
+void BM_PushParse(benchmark::State &state)
+{
+    const std::string_view input = exampleInput();
+    const auto chunkSize = static_cast<std::size_t>(state.range(0));
+    auto parser = cpplibxml2::PushParser::create();
+    for (auto _ : state)
+    {
+        for (std::size_t offset = 0; offset < input.size(); offset += chunkSize)
+            benchmark::DoNotOptimize(parser.value().feed(input.substr(offset, chunkSize)));
+        auto doc = parser.value().finish();
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(input.size()));
+}
+BENCHMARK(BM_PushParse)->RangeMultiplier(4)->Range(16, 16 << 10);
+} // namespace
@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include "corpus.hpp"
+
+#include <recordSplitter.hpp>
+
+// Processing every record of a feed: parsing the whole document and walking its records, against splitting it into
+// one Doc per record with bounded memory, sequentially and on worker threads.
+
+namespace
+{
+const std::string &feed()
+{
+    return corpus::get(corpus::Shape::Wide, 8192);
+}
+
+std::int64_t priceOf(const cpplibxml2::Node &item)
+{
+    return item.findChild("price").value().valueAs<double>().value() > 0 ? 1 : 0;
+}
+
+void BM_RecordsWholeDoc(benchmark::State &state)
+{
+    std::int64_t records = 0;
+    for (auto _ : state)
+    {
+        const auto doc = cpplibxml2::Doc::parse(feed()).value();
+        for (const auto &item : doc.root().value().elements())
+            records += priceOf(item);
+    }
+    state.SetItemsProcessed(records);
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(feed().size()));
+}
+BENCHMARK(BM_RecordsWholeDoc)->Unit(benchmark::kMillisecond);
+
+void BM_RecordsSplit(benchmark::State &state)
+{
+    std::int64_t records = 0;
+    for (auto _ : state)
+    {
+        auto splitter = cpplibxml2::RecordSplitter::open(feed(), "item").value();
+        std::ignore = splitter.forEach(
+            [&records](std::size_t, cpplibxml2::Doc &&record) { records += priceOf(record.root().value()); });
+    }
+    state.SetItemsProcessed(records);
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(feed().size()));
+}
+BENCHMARK(BM_RecordsSplit)->Unit(benchmark::kMillisecond);
+
+void BM_RecordsSplitParallel(benchmark::State &state)
+{
+    const auto order = state.range(1) != 0 ? cpplibxml2::RecordOrder::Ordered : cpplibxml2::RecordOrder::Unordered;
+    std::int64_t records = 0;
+    for (auto _ : state)
+    {
+        auto splitter = cpplibxml2::RecordSplitter::open(feed(), "item").value();
+        records += static_cast<std::int64_t>(
+            splitter
+                .transform(
+                    static_cast<std::size_t>(state.range(0)), order,
+                    [](std::size_t, cpplibxml2::Doc &&record) { return priceOf(record.root().value()); },
+                    [](std::size_t, std::int64_t) {})
+                .value());
+    }
+    state.SetItemsProcessed(records);
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(feed().size()));
+}
+BENCHMARK(BM_RecordsSplitParallel)
+    ->ArgsProduct({{1, 2, 4}, {0, 1}})
+    ->ArgNames({"threads", "ordered"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+} // namespace
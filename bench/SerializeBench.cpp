@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include <outputSink.hpp>
+
+#include <array>
+#include <string>
+
+namespace
+{
+cpplibxml2::Doc makeCatalog(const std::int64_t items)
+{
+    std::string xml = R"(<?xml version="1.0" encoding="UTF-8"?><catalog>)";
+    for (std::int64_t i = 0; i < items; ++i)
+    {
+        xml += R"(<item id=")" + std::to_string(i) + R"("><name>item &amp; )" + std::to_string(i) +
+               "</name><price>" + std::to_string(i * 3) + "</price></item>";
+    }
+    xml += "</catalog>";
+    return cpplibxml2::Doc::parse(xml).value();
+}
+
+// dump() materializes the whole output twice (libxml2 buffer and std::string); the sink only ever holds one chunk.
+
+void BM_SerializeDump(benchmark::State &state)
+{
+    const auto doc = makeCatalog(state.range(0));
+    std::int64_t bytes = 0;
+    for (auto _ : state)
+    {
+        auto out = doc.dump();
+        bytes += static_cast<std::int64_t>(out.value().size());
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_SerializeDump)->Arg(1 << 10)->Arg(1 << 16);
+
+void BM_SerializeSink(benchmark::State &state)
+{
+    const auto doc = makeCatalog(state.range(0));
+    std::array<char, 64 * 1024> buffer{};
+    std::int64_t bytes = 0;
+    const auto sink = cpplibxml2::OutputSink{buffer, [&bytes](const std::string_view chunk) {
+                                                 bytes += static_cast<std::int64_t>(chunk.size());
+                                                 benchmark::DoNotOptimize(chunk.data());
+                                                 return true;
+                                             }};
+    for (auto _ : state)
+    {
+        auto result = doc.serialize(sink);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_SerializeSink)->Arg(1 << 10)->Arg(1 << 16);
+} // namespace
@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include "corpus.hpp"
+
+#include <cpplibxml2.hpp>
+#include <structuralIndex.hpp>
+
+#include <string>
+
+// Building the structural index of the 8 MiB corpora at every SIMD level, against a full parse, and skimming one
+// field out of every record of a feed through the index instead of parsing the whole document.
+
+namespace
+{
+using corpus::Shape;
+using cpplibxml2::SimdLevel;
+
+constexpr std::size_t kib = 8192;
+
+void buildIndex(benchmark::State &state, const Shape shape, const SimdLevel level)
+{
+    const auto &xml = corpus::get(shape, kib);
+    if (cpplibxml2::StructuralIndex::supportedLevel() < level)
+    {
+        state.SkipWithError("The CPU does not support this level");
+        return;
+    }
+    for (auto _ : state)
+    {
+        auto index = cpplibxml2::StructuralIndex::build(xml, level);
+        benchmark::DoNotOptimize(index);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(xml.size()));
+}
+
+void parse(benchmark::State &state, const Shape shape)
+{
+    const auto &xml = corpus::get(shape, kib);
+    for (auto _ : state)
+    {
+        auto doc = cpplibxml2::Doc::parse(xml);
+        benchmark::DoNotOptimize(doc);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(xml.size()));
+}
+
+double priceOf(const cpplibxml2::Node &item)
+{
+    return item.findChild("price").value().valueAs<double>().value();
+}
+
+void BM_SkimParse(benchmark::State &state)
+{
+    const auto &xml = corpus::get(Shape::Wide, kib);
+    for (auto _ : state)
+    {
+        double total = 0;
+        const auto doc = cpplibxml2::Doc::parse(xml).value();
+        for (const auto &item : doc.root().value().elements())
+            total += priceOf(item);
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(xml.size()));
+}
+BENCHMARK(BM_SkimParse)->Unit(benchmark::kMillisecond);
+
+void BM_SkimIndex(benchmark::State &state)
+{
+    const auto &xml = corpus::get(Shape::Wide, kib);
+    for (auto _ : state)
+    {
+        double total = 0;
+        const auto index = cpplibxml2::StructuralIndex::build(xml).value();
+        for (const auto &price : index.records("price"))
+        {
+            const auto text = price.text(xml);
+            total += std::stod(std::string{text.substr(text.find('>') + 1)});
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(xml.size()));
+}
+BENCHMARK(BM_SkimIndex)->Unit(benchmark::kMillisecond);
+
+[[maybe_unused]] const int registered = [] {
+    constexpr std::pair<std::string_view, SimdLevel> levels[]{
+        {"scalar", SimdLevel::Scalar}, {"sse2", SimdLevel::Sse2}, {"avx2", SimdLevel::Avx2}};
+    for (const auto shape : corpus::shapes)
+    {
+        const auto suffix = std::string{"/"}.append(corpus::name(shape));
+        for (const auto &[levelName, level] : levels)
+        {
+            benchmark::RegisterBenchmark(std::string{"BM_StructuralIndex/"}.append(levelName).append(suffix).c_str(),
+                                         buildIndex, shape, level)
+                ->Unit(benchmark::kMillisecond);
+        }
+        benchmark::RegisterBenchmark(std::string{"BM_StructuralIndexParse"}.append(suffix).c_str(), parse, shape)
+            ->Unit(benchmark::kMillisecond);
+    }
+    return 0;
+}();
+} // namespace
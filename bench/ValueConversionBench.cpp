@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <cpplibxml2.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+/**
+ * A record list whose <value> children are numbers, except every `dirtyEvery`-th one (0 = never).
+ */
+std::string makeValueDocument(const std::size_t records, const std::size_t dirtyEvery)
+{
+    std::string xml = R"(<?xml version="1.0"?><root>)";
+    for (std::size_t i = 0; i < records; ++i)
+    {
+        const bool dirty = dirtyEvery != 0 && i % dirtyEvery == 0;
+        xml += "<value>" + (dirty ? std::string{"n/a"} : std::to_string(i) + ".25") + "</value>";
+    }
+    xml += "</root>";
+    return xml;
+}
+
+std::vector<cpplibxml2::Node> valueNodes(const cpplibxml2::Doc &doc)
+{
+    std::vector<cpplibxml2::Node> nodes;
+    for (const auto node : doc.root().value().elements())
+        nodes.push_back(node);
+    return nodes;
+}
+
+constexpr std::size_t records = 1024;
+
+void BM_ValueAsDouble(benchmark::State &state)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeValueDocument(records, static_cast<std::size_t>(state.range(0))));
+    const auto nodes = valueNodes(doc.value());
+    for (auto _ : state)
+    {
+        for (const auto &node : nodes)
+        {
+            auto value = node.valueAsDouble();
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(nodes.size()));
+}
+BENCHMARK(BM_ValueAsDouble)->Arg(0)->Arg(10)->Arg(1);
+
+void BM_ValueAsTemplateDouble(benchmark::State &state)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeValueDocument(records, static_cast<std::size_t>(state.range(0))));
+    const auto nodes = valueNodes(doc.value());
+    for (auto _ : state)
+    {
+        for (const auto &node : nodes)
+        {
+            auto value = node.valueAs<double>();
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(nodes.size()));
+}
+BENCHMARK(BM_ValueAsTemplateDouble)->Arg(0)->Arg(10)->Arg(1);
+
+void BM_ValueAsInt(benchmark::State &state)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeValueDocument(records, static_cast<std::size_t>(state.range(0))));
+    const auto nodes = valueNodes(doc.value());
+    for (auto _ : state)
+    {
+        for (const auto &node : nodes)
+        {
+            auto value = node.valueAsInt();
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(nodes.size()));
+}
+BENCHMARK(BM_ValueAsInt)->Arg(0)->Arg(10)->Arg(1);
+
+void BM_ValueAsTemplateInt(benchmark::State &state)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeValueDocument(records, static_cast<std::size_t>(state.range(0))));
+    const auto nodes = valueNodes(doc.value());
+    for (auto _ : state)
+    {
+        for (const auto &node : nodes)
+        {
+            // The generated values carry a fraction, so the strict parser rejects every one of them: this measures
+            // the pure error path.
+            auto value = node.valueAs<int>();
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(nodes.size()));
+}
+BENCHMARK(BM_ValueAsTemplateInt)->Arg(0)->Arg(10)->Arg(1);
+} // namespace
@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+
+#include <writer.hpp>
+
+#include <array>
+#include <string>
+
+namespace
+{
+// Both variants produce the same export into a discarding sink; the DOM variant holds every record until the end.
+
+auto discardingSink(std::array<char, 64 * 1024> &buffer, std::int64_t &bytes)
+{
+    return cpplibxml2::OutputSink{buffer, [&bytes](const std::string_view chunk) {
+                                      bytes += static_cast<std::int64_t>(chunk.size());
+                                      benchmark::DoNotOptimize(chunk.data());
+                                      return true;
+                                  }};
+}
+
+void BM_ExportDom(benchmark::State &state)
+{
+    std::array<char, 64 * 1024> buffer{};
+    std::int64_t bytes = 0;
+    for (auto _ : state)
+    {
+        const auto doc = cpplibxml2::Doc::parse(R"(<?xml version="1.0" encoding="UTF-8"?><export/>)").value();
+        const auto root = doc.root().value();
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+        {
+            const auto record = root.addChild("record").value();
+            record.addChild("id").value().addValue(std::to_string(i));
+            record.addChild("name").value().addValue("record name");
+            record.addChild("amount").value().addValue(std::to_string(i * 3));
+        }
+        auto result = doc.serialize(discardingSink(buffer, bytes));
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(bytes);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ExportDom)->Arg(1 << 10)->Arg(1 << 16);
+
+void BM_ExportWriter(benchmark::State &state)
+{
+    std::array<char, 64 * 1024> buffer{};
+    std::int64_t bytes = 0;
+    for (auto _ : state)
+    {
+        auto writer = cpplibxml2::Writer::toSink(discardingSink(buffer, bytes)).value();
+        (void)writer.startDocument();
+        (void)writer.startElement("export");
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+        {
+            (void)writer.startElement("record");
+            (void)writer.element("id", std::to_string(i));
+            (void)writer.element("name", "record name");
+            (void)writer.element("amount", std::to_string(i * 3));
+            (void)writer.endElement();
+        }
+        auto result = writer.finish();
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(bytes);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ExportWriter)->Arg(1 << 10)->Arg(1 << 16);
+} // namespace
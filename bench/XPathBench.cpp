@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include <xpath.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr std::string_view expression = "/order/line[@sku='B']/@amount";
+
+std::vector<cpplibxml2::Doc> makeOrders(const std::size_t count)
+{
+    std::vector<cpplibxml2::Doc> docs;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto xml = R"(<?xml version="1.0"?><order id=")" + std::to_string(i) +
+                         R"("><line sku="A" amount="1"/><line sku="B" amount="2"/><line sku="C" amount="3"/></order>)";
+        docs.push_back(std::move(cpplibxml2::Doc::parse(xml).value()));
+    }
+    return docs;
+}
+
+constexpr std::size_t documents = 256;
+
+// One query per small document, as in record extraction: the compile step dominates unless it is hoisted.
+
+void BM_XPathAdHoc(benchmark::State &state)
+{
+    const auto docs = makeOrders(documents);
+    for (auto _ : state)
+    {
+        for (const auto &doc : docs)
+        {
+            auto context = cpplibxml2::XPathContext::create(doc);
+            auto result = context.value().evaluate(expression);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(docs.size()));
+}
+BENCHMARK(BM_XPathAdHoc);
+
+void BM_XPathPrecompiled(benchmark::State &state)
+{
+    const auto docs = makeOrders(documents);
+    const auto compiled = cpplibxml2::XPathExpression::compile(expression);
+    auto context = cpplibxml2::XPathContext::create(docs.front());
+    for (auto _ : state)
+    {
+        for (const auto &doc : docs)
+        {
+            context.value().setDocument(doc);
+            auto result = context.value().evaluate(compiled.value());
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(docs.size()));
+}
+BENCHMARK(BM_XPathPrecompiled);
+
+void BM_XPathDocQuery(benchmark::State &state)
+{
+    const auto docs = makeOrders(documents);
+    for (auto _ : state)
+    {
+        for (const auto &doc : docs)
+        {
+            auto result = doc.query(expression);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(docs.size()));
+}
+BENCHMARK(BM_XPathDocQuery);
+} // namespace
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace corpus
+{
+/**
+ * Shapes of the generated documents. Each stresses a different part of the parser and of the tree walk.
+ */
+enum class Shape
+{
+    Wide,           /* many small sibling records under the root */
+    Deep,           /* records nested 48 levels deep */
+    AttributeHeavy, /* empty elements carrying 16 attributes each */
+    TextHeavy,      /* few elements with long text containing entity and character references */
+    NamespaceHeavy  /* prefixed and default namespaces, modelled on test/testData/nsExample.xml */
+};
+
+inline constexpr std::array shapes{Shape::Wide, Shape::Deep, Shape::AttributeHeavy, Shape::TextHeavy,
+                                   Shape::NamespaceHeavy};
+
+/**
+ * Approximate document sizes in KiB.
+ */
+inline constexpr std::array<std::size_t, 3> sizes{16, 1024, 8192};
+
+[[nodiscard]] constexpr std::string_view name(const Shape shape) noexcept
+{
+    switch (shape)
+    {
+    case Shape::Wide:
+        return "wide";
+    case Shape::Deep:
+        return "deep";
+    case Shape::AttributeHeavy:
+        return "attributes";
+    case Shape::TextHeavy:
+        return "text";
+    case Shape::NamespaceHeavy:
+        return "namespaces";
+    }
+    return "unknown";
+}
+
+/**
+ * An element name present in every record of the shape, for findChild lookups.
+ */
+[[nodiscard]] constexpr std::string_view probe(const Shape shape) noexcept
+{
+    switch (shape)
+    {
+    case Shape::Wide:
+        return "price";
+    case Shape::Deep:
+        return "level";
+    case Shape::AttributeHeavy:
+        return "row";
+    case Shape::TextHeavy:
+        return "para";
+    case Shape::NamespaceHeavy:
+        return "Version";
+    }
+    return "";
+}
+
+namespace detail
+{
+inline void appendRecord(std::string &xml, const Shape shape, const std::size_t i)
+{
+    const auto n = std::to_string(i);
+    switch (shape)
+    {
+    case Shape::Wide:
+        xml.append("<item id=\"").append(n).append("\"><name>item ").append(n).append("</name><price>");
+        xml.append(n).append(".50</price><stock>").append(std::to_string(i % 97)).append("</stock></item>");
+        break;
+    case Shape::Deep:
+        for (int level = 0; level < 48; ++level)
+            xml.append("<level depth=\"").append(std::to_string(level)).append("\">");
+        xml.append("<leaf>").append(n).append("</leaf>");
+        for (int level = 0; level < 48; ++level)
+            xml.append("</level>");
+        break;
+    case Shape::AttributeHeavy:
+        xml.append("<row");
+        for (int attr = 0; attr < 16; ++attr)
+        {
+            xml.append(" a").append(std::to_string(attr)).append("=\"").append(n).append("-");
+            xml.append(std::to_string(attr)).append("\"");
+        }
+        xml.append("/>");
+        break;
+    case Shape::TextHeavy:
+        xml.append("<section n=\"").append(n).append("\"><title>Section ").append(n).append("</title><para>");
+        for (int sentence = 0; sentence < 12; ++sentence)
+            xml.append("The quick brown fox &amp; the lazy dog jump over &lt;fence&gt; number ")
+                .append(n)
+                .append(" &#x263A;. ");
+        xml.append("</para></section>");
+        break;
+    case Shape::NamespaceHeavy:
+        xml.append("<ns2:Service Name=\"Service").append(n).append("\"><ns2:Abstract>service ").append(n);
+        xml.append("</ns2:Abstract><ns2:Versions><ns2:Version TargetNamespace=\"urn:s").append(n);
+        xml.append("\" Version=\"1.").append(std::to_string(i % 10)).append("\"><ns2:EndpointTLS Location=\"https://");
+        xml.append("konnektor/").append(n).append("\"/><ns3:Info xmlns:ns3=\"http://ws.gematik.de/conn/Info/v2.0\">");
+        xml.append("<ns3:Status>OK</ns3:Status></ns3:Info><ProductName>Product ").append(n);
+        xml.append("</ProductName></ns2:Version></ns2:Versions></ns2:Service>");
+        break;
+    }
+}
+} // namespace detail
+
+/**
+ * Generates a document of the given shape of at least `kib` KiB. Deterministic, so results are comparable between
+ * runs and versions.
+ */
+[[nodiscard]] inline std::string generate(const Shape shape, const std::size_t kib)
+{
+    std::string xml = R"(<?xml version="1.0" encoding="UTF-8"?>)";
+    if (shape == Shape::NamespaceHeavy)
+        xml.append(R"(<ns2:ConnectorServices xmlns="http://ws.gematik.de/int/version/ProductInformation/v1.1" )"
+                   R"(xmlns:ns2="http://ws.gematik.de/conn/ServiceDirectory/v3.1">)");
+    else
+        xml.append("<corpus>");
+
+    const auto target = kib * 1024;
+    xml.reserve(target + 4096);
+    for (std::size_t i = 0; xml.size() < target; ++i)
+        detail::appendRecord(xml, shape, i);
+
+    xml.append(shape == Shape::NamespaceHeavy ? "</ns2:ConnectorServices>" : "</corpus>");
+    return xml;
+}
+
+/**
+ * Generated documents are cached for the lifetime of the benchmark run, generating the large ones for every
+ * benchmark would dominate the run time.
+ */
+[[nodiscard]] inline const std::string &get(const Shape shape, const std::size_t kib)
+{
+    static std::map<std::pair<Shape, std::size_t>, std::string> cache;
+    auto it = cache.find({shape, kib});
+    if (it == cache.end())
+        it = cache.emplace(std::pair{shape, kib}, generate(shape, kib)).first;
+    return it->second;
+}
+} // namespace corpus
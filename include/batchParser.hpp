@@ -0,0 +1,69 @@
+#pragma once
+
+#include "cpplibxml2.hpp"
+
+#include <functional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace cpplibxml2
+{
+/**
+ * Parses many independent documents on a pool of worker threads.
+ *
+ * Workers pull the next input from a shared atomic index, so a few large inputs do not hold up the rest of the batch.
+ * Every worker parses with its own Parser (see parser.hpp), created for the batch; the calling thread works as one of
+ * them. libxml2 is initialized once on the calling thread before any worker starts.
+ *
+ * Only one batch may run on a BatchParser at a time. The resulting Docs can be used and destroyed on any thread once
+ * the batch call has returned, also while later batches run. With the callback overloads a Doc may be destroyed
+ * inside the callback, but if it is handed to another thread it must not be destroyed there before the batch call
+ * returns, because the worker that produced it is still using the shared name dictionary. Building on a Doc adds
+ * names to that dictionary (see Parser), so it must not overlap with other threads destroying or building on Docs of
+ * the same batch.
+ */
+class BatchParser
+{
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+
+  public:
+    using Result = std::expected<Doc, RuntimeError>;
+
+    /**
+     * Receives the index of the input and its result. Calls are serialized but come from the worker threads, in
+     * completion order. An exception thrown by the callback stops the batch and is rethrown by the batch call.
+     */
+    using Callback = std::function<void(std::size_t, Result &&)>;
+
+    /**
+     * @param threads Number of threads, including the calling one; 0 uses std::thread::hardware_concurrency()
+     * @param options libxml2 parser options for every input
+     */
+    explicit BatchParser(std::size_t threads = 0, ParserOptions options = ParserOptions::NoEnt | ParserOptions::DtdLoad);
+
+    BatchParser(const BatchParser &) = delete;
+
+    BatchParser(BatchParser &&) noexcept;
+
+    ~BatchParser();
+
+    BatchParser &operator=(const BatchParser &) = delete;
+
+    BatchParser &operator=(BatchParser &&) noexcept;
+
+    [[nodiscard]] std::size_t threads() const noexcept;
+
+    /**
+     * @return One result per input, in input order
+     */
+    [[nodiscard]] std::vector<Result> parseFiles(std::span<const std::filesystem::path> paths);
+
+    [[nodiscard]] std::vector<Result> parse(std::span<const std::string_view> inputs);
+
+    void parseFiles(std::span<const std::filesystem::path> paths, const Callback &callback);
+
+    void parse(std::span<const std::string_view> inputs, const Callback &callback);
+};
+} // namespace cpplibxml2
@@ -2,12 +2,22 @@
 
 #include "errorTypes.hpp"
 
+#include <concepts>
 #include <expected>
 #include <filesystem>
+#include <iosfwd>
+#include <iterator>
 #include <memory>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
+struct _xmlDict;
+struct _xmlNode;
+
 namespace cpplibxml2
 {
 enum class ParserOptions : int
@@ -74,6 +84,81 @@ inline ParserOptions &operator&=(ParserOptions &lhs, const ParserOptions rhs)
 }
 
 class Node;
+class NodeIterator;
+class NodeRange;
+class OutputSink;
+class XPathNodeIterator;
+class XPathResult;
+
+/**
+ * libxml2 node types, see xmlElementType.
+ */
+enum class NodeType : int
+{
+    Element = 1,
+    Attribute = 2,
+    Text = 3,
+    CData = 4,
+    EntityRef = 5,
+    Entity = 6,
+    ProcessingInstruction = 7,
+    Comment = 8,
+    Document = 9,
+    DocumentType = 10,
+    DocumentFragment = 11,
+    Notation = 12,
+    HtmlDocument = 13,
+    Dtd = 14,
+    ElementDecl = 15,
+    AttributeDecl = 16,
+    EntityDecl = 17,
+    NamespaceDecl = 18,
+    XIncludeStart = 19,
+    XIncludeEnd = 20
+};
+
+/**
+ * The direction a NodeRange walks, relative to the node it was created from.
+ */
+enum class NodeAxis
+{
+    Children,    /* all child nodes, including text and comments */
+    Elements,    /* element children */
+    Siblings,    /* following element siblings */
+    Descendants, /* element descendants in document order (pre-order) */
+    Ancestors    /* element ancestors, nearest first */
+};
+
+/**
+ * Types the from_chars based conversions (parseValue, Node::valueAs) support.
+ */
+template <typename T>
+concept Convertible = std::same_as<T, bool> || std::same_as<T, short> || std::same_as<T, unsigned short> ||
+                      std::same_as<T, int> || std::same_as<T, unsigned int> || std::same_as<T, long> ||
+                      std::same_as<T, unsigned long> || std::same_as<T, long long> ||
+                      std::same_as<T, unsigned long long> || std::same_as<T, float> || std::same_as<T, double>;
+
+/**
+ * Convert XML text to T without throwing or allocating.
+ * Leading and trailing XML whitespace is ignored and the rest has to be consumed completely, so "42abc" or "4 2" are
+ * rejected. Numbers may carry a leading '+'. bool accepts the xsd:boolean lexical forms "true", "false", "1" and "0".
+ *
+ * @param text The text to convert
+ * @param base Radix for integer types, ignored for bool and floating point types
+ * @return std::expected<T, ConversionError>
+ *         - contains the converted value on success
+ *         - contains the reason of the failure otherwise
+ */
+template <Convertible T>
+[[nodiscard]] std::expected<T, ConversionError> parseValue(std::string_view text, int base = 10) noexcept;
+
+namespace detail
+{
+struct Access;
+
+[[nodiscard]] _xmlNode *first(NodeAxis axis, _xmlNode *origin) noexcept;
+[[nodiscard]] _xmlNode *next(NodeAxis axis, _xmlNode *current, const _xmlNode *origin) noexcept;
+} // namespace detail
 
 enum class Format
 {
@@ -110,6 +195,48 @@ enum class Format
     }
 }
 
+/**
+ * A pre-resolved element name for repeated lookups, obtained from Doc::nameKey().
+ * libxml2 interns element names in the document dictionary, so once a name has been looked up there, matching a
+ * node is a single pointer comparison instead of a string comparison. Nodes of documents with another (or no)
+ * dictionary are still matched correctly by comparing the names as strings. A key holds a reference on the
+ * dictionary, so it may outlive its document. Keys of documents from Doc::parseInArena compare names as strings.
+ */
+class NameKey
+{
+    _xmlDict *dict = nullptr;
+    const unsigned char *interned = nullptr;
+    std::string name;
+
+    friend class Doc;
+    friend class Node;
+
+  public:
+    NameKey() = default;
+
+    NameKey(const NameKey &other);
+
+    NameKey(NameKey &&other) noexcept;
+
+    ~NameKey();
+
+    NameKey &operator=(const NameKey &other);
+
+    NameKey &operator=(NameKey &&other) noexcept;
+
+    [[nodiscard]] std::string_view view() const noexcept
+    {
+        return this->name;
+    }
+};
+
+/**
+ * An owned libxml2 document.
+ *
+ * Thread safety: different Docs can be used from different threads freely, and the static parse functions can be
+ * called concurrently. A single Doc and its Nodes must not be used from several threads at once; move it into a
+ * FrozenDoc (frozenDoc.hpp) to share it read-only between threads.
+ */
 class Doc
 {
     struct Impl;
@@ -117,6 +244,8 @@ class Doc
 
     Doc();
 
+    friend struct detail::Access;
+
   public:
     Doc(const Doc &) = delete;
 
@@ -131,15 +260,96 @@ class Doc
     [[nodiscard]] static std::expected<Doc, RuntimeError> parseFile(
         const std::filesystem::path &, ParserOptions options = ParserOptions::NoEnt | ParserOptions::DtdLoad) noexcept;
 
+    /**
+     * Parses a file by memory-mapping it and reading straight out of the mapped pages, instead of going through
+     * libxml2's buffered file I/O. Prefer this for large files.
+     *
+     * @param path The file to parse
+     * @param options libxml2 parser options
+     * @return The parsed document or an error
+     */
+    [[nodiscard]] static std::expected<Doc, RuntimeError> parseMappedFile(
+        const std::filesystem::path &path, ParserOptions options = ParserOptions::NoEnt | ParserOptions::DtdLoad) noexcept;
+
+    /**
+     * Parses a document held in memory. Inputs beyond 2 GiB, more than libxml2's memory parser takes, are fed to the
+     * parser in chunks. Very large documents usually need ParserOptions::Huge as well, for text nodes over 10 MB or
+     * deeply nested trees.
+     */
     [[nodiscard]] static std::expected<Doc, RuntimeError> parse(std::string_view,
                                                                 ParserOptions = ParserOptions::NoEnt |
                                                                                 ParserOptions::DtdLoad) noexcept;
 
+    /**
+     * Parses a document read from `input` in chunks of a few kilobytes, so only the tree is held in memory and not
+     * the input; there is no limit on the input size. Reading starts at the current position and stops at the end of
+     * the stream.
+     *
+     * @param input The stream to read from; exceptions it throws are reported as errors
+     * @param options libxml2 parser options
+     * @return The parsed document or an error
+     */
+    [[nodiscard]] static std::expected<Doc, RuntimeError> parse(std::istream &input,
+                                                                ParserOptions options = ParserOptions::NoEnt |
+                                                                                        ParserOptions::DtdLoad) noexcept;
+
+#ifdef CPPLIBXML2_ENABLE_ARENA
+    /**
+     * Parses into a private bump arena (requires the CPPLIBXML2_ENABLE_ARENA build option).
+     *
+     * Every allocation libxml2 makes for the document comes out of one arena, and destroying the Doc releases the
+     * arena in one step instead of freeing node by node. Meant for request-scoped, read-only documents: nodes or
+     * values added to the tree later are allocated normally and are not reclaimed when the Doc is destroyed.
+     */
+    [[nodiscard]] static std::expected<Doc, RuntimeError> parseInArena(std::string_view,
+                                                                       ParserOptions = ParserOptions::NoEnt |
+                                                                                       ParserOptions::DtdLoad) noexcept;
+#endif
+
+    /**
+     * Creates an empty document with a root element named `rootName`, for building a tree from scratch.
+     * The document gets its own dictionary, so element and attribute names added with the Node builder functions
+     * are stored once per document instead of once per node.
+     */
+    [[nodiscard]] static std::expected<Doc, RuntimeError> create(std::string_view rootName) noexcept;
+
     [[nodiscard]] std::expected<Node, RuntimeError> root() const noexcept;
 
+    /**
+     * Resolve an element name against the document's dictionary once, for pointer-equality matching with
+     * Node::findChild(const NameKey &) and Node::elements(const NameKey &). Names added to the document after the
+     * key was resolved require a new key.
+     */
+    [[nodiscard]] NameKey nameKey(std::string_view name) const;
+
+    /**
+     * Like nameKey(), but adds the name to the dictionary if it is not there yet. Use it for the names passed to
+     * Node::addChild(const NameKey &) while building a document. Docs from a Parser or BatchParser share their
+     * dictionary with other Docs, so this and the Node builder functions have their thread restrictions, see Parser.
+     */
+    [[nodiscard]] NameKey intern(std::string_view name);
+
+    /**
+     * Evaluates an XPath expression (see xpath.hpp) against this document.
+     * Compiled expressions and the evaluation context are cached in the document, so repeating a query only pays
+     * for the evaluation. The cache keeps the 64 most recently used expressions; queries that are rarely repeated,
+     * e.g. built from data, can bypass it with XPathExpression and XPathContext. The prefixed namespaces declared on
+     * the root element are registered automatically. Like every other operation on a Doc this is not thread-safe.
+     */
+    [[nodiscard]] std::expected<XPathResult, RuntimeError> query(std::string_view expression) const;
+
+    [[nodiscard]] std::expected<XPathResult, RuntimeError> query(std::string_view expression, Node context) const;
+
     [[nodiscard]] std::expected<std::string, RuntimeError> dump(bool addWhiteSpaces = false,
                                                                 Format format = Format::UTF_8) const noexcept;
 
+    /**
+     * Writes the document to `sink` (see outputSink.hpp) as it is serialized, instead of building it in memory like
+     * dump() does. The output is the same as dump() with the same arguments.
+     */
+    [[nodiscard]] std::expected<void, RuntimeError> serialize(OutputSink sink, bool addWhiteSpaces = false,
+                                                              Format format = Format::UTF_8) const;
+
     /**
      * Writes the XML document to the given file path.
      *
@@ -153,25 +363,41 @@ class Doc
                                                                Format format = Format::UTF_8) const noexcept;
 };
 
+/**
+ * Non-owning handle to a node of a Doc.
+ *
+ * A Node is a single pointer into the libxml2 tree: it is trivially copyable, never allocates and stays valid for as
+ * long as the owning Doc is alive and the node is not removed from it. Copies refer to the same underlying node.
+ * Code written against the former move-only Node keeps compiling; moves are now plain copies.
+ */
 class Node
 {
-    Node();
+    _xmlNode *handle = nullptr;
 
-    struct Impl;
-    std::unique_ptr<Impl> impl;
+    explicit Node(_xmlNode *node) noexcept : handle(node)
+    {
+    }
 
     friend class Doc;
+    friend class NodeIterator;
+    friend class XPathNodeIterator;
+    friend struct detail::Access;
 
   public:
-    Node(const Node &) = delete;
+    Node(const Node &) noexcept = default;
 
-    Node(Node &&) noexcept;
+    Node(Node &&) noexcept = default;
 
-    ~Node();
+    ~Node() = default;
 
-    Node &operator=(const Node &) = delete;
+    Node &operator=(const Node &) noexcept = default;
 
-    Node &operator=(Node &&) noexcept;
+    Node &operator=(Node &&) noexcept = default;
+
+    /**
+     * Two handles are equal if they refer to the same underlying node.
+     */
+    [[nodiscard]] friend bool operator==(const Node &, const Node &) noexcept = default;
 
     [[nodiscard]] std::expected<std::string_view, RuntimeError> name() const noexcept;
 
@@ -180,10 +406,47 @@ class Node
     [[nodiscard]] std::expected<Node, RuntimeError> findChild(std::string_view name,
                                                               std::string_view nsUri) const noexcept;
 
+    [[nodiscard]] std::expected<Node, RuntimeError> findChild(const NameKey &key) const noexcept;
+
+    [[nodiscard]] bool hasName(const NameKey &key) const noexcept;
+
     [[nodiscard]] std::expected<std::vector<Node>, RuntimeError> getChildren() const noexcept;
 
+    [[nodiscard]] NodeType type() const noexcept;
+
+    /**
+     * Lazy views over the libxml2 sibling/parent links. They never allocate, are invalidated like Node handles and
+     * compose with the standard range adaptors, e.g. `node.elements() | std::views::take(1)`.
+     */
+    [[nodiscard]] NodeRange children() const noexcept;
+    [[nodiscard]] NodeRange elements() const noexcept;
+    [[nodiscard]] NodeRange siblings() const noexcept;
+    [[nodiscard]] NodeRange descendants() const noexcept;
+    [[nodiscard]] NodeRange ancestors() const noexcept;
+
+    /**
+     * Element children named `key`.
+     */
+    [[nodiscard]] auto elements(const NameKey &key) const;
+
     [[nodiscard]] std::expected<std::string, RuntimeError> value() const noexcept;
 
+    /**
+     * Borrow the node's text content without copying it.
+     * Succeeds when libxml2 stores the text contiguously: text, CDATA, comment and PI nodes, empty elements and
+     * elements with a single text or CDATA child. The view lives as long as the node is left unmodified.
+     *
+     * @return std::expected<std::string_view, RuntimeError>
+     *         - a view into the document on success
+     *         - an error if the node is null or its content is spread over several nodes
+     */
+    [[nodiscard]] std::expected<std::string_view, RuntimeError> valueView() const noexcept;
+    /**
+     * Same as valueView(), but mixed content is concatenated into `buffer` instead of failing.
+     * Reusing one buffer across calls keeps allocations off the hot path; the returned view refers either to the
+     * document or to `buffer`.
+     */
+    [[nodiscard]] std::expected<std::string_view, RuntimeError> valueView(std::string &buffer) const;
 
     /**
      * Retrieve the node’s text content and convert it to a float.
@@ -236,19 +499,297 @@ class Node
      */
     [[nodiscard]] std::expected<long long, InvalidArgument> valueAsLongLong(int base = 10) const;
 
+    /**
+     * Retrieve the node's text content converted to T with parseValue().
+     * Unlike the valueAsX() family this never throws and does not allocate when the text is contiguous (see
+     * valueView()).
+     *
+     * @return std::expected<T, ConversionError>
+     *         - contains the converted value on success
+     *         - contains the reason of the failure otherwise
+     */
+    template <Convertible T>
+    [[nodiscard]] std::expected<T, ConversionError> valueAs(int base = 10) const noexcept;
+
     [[nodiscard]] std::expected<std::pair<std::string_view, std::string_view>, RuntimeError> findProperty(
         std::string_view name) const noexcept;
 
+    /**
+     * Namespace-aware variant of findProperty(): matches the attribute's local name and namespace URI. An empty
+     * `nsUri` matches attributes without a namespace.
+     */
+    [[nodiscard]] std::expected<std::pair<std::string_view, std::string_view>, RuntimeError> findProperty(
+        std::string_view name, std::string_view nsUri) const noexcept;
+
+    /**
+     * Allocation-free attribute lookup. Returns std::nullopt if the node is null or has no such attribute.
+     */
+    [[nodiscard]] std::optional<std::string_view> attribute(std::string_view name) const noexcept;
+    [[nodiscard]] std::optional<std::string_view> attribute(std::string_view name,
+                                                            std::string_view nsUri) const noexcept;
+
+    /**
+     * Retrieve an attribute value converted to T with parseValue().
+     *
+     * @return std::expected<T, ConversionError>
+     *         - contains the converted value on success
+     *         - ConversionError::NoValue if the attribute does not exist, otherwise the conversion failure
+     */
+    template <Convertible T>
+    [[nodiscard]] std::expected<T, ConversionError> attributeAs(std::string_view name, int base = 10) const noexcept;
+    template <Convertible T>
+    [[nodiscard]] std::expected<T, ConversionError> attributeAs(std::string_view name, std::string_view nsUri,
+                                                                int base = 10) const noexcept;
+
     [[nodiscard]] std::vector<std::pair<std::string_view, std::string_view>> getProperties() const noexcept;
 
     [[nodiscard]] std::pair<std::string_view, std::string_view> getNamespace() const noexcept;
 
+    /**
+     * Writes this node and its subtree to `sink` (see outputSink.hpp), without an XML declaration. Namespaces
+     * declared on ancestors are not repeated, so the output of a namespaced subtree may not be a standalone document.
+     */
+    [[nodiscard]] std::expected<void, RuntimeError> serialize(OutputSink sink, bool addWhiteSpaces = false,
+                                                              Format format = Format::UTF_8) const;
+
     [[nodiscard]] std::expected<Node, RuntimeError> addChild(std::string_view) const noexcept;
 
+    /**
+     * Appends a child element whose name was interned with Doc::intern(), skipping the dictionary lookup.
+     */
+    [[nodiscard]] std::expected<Node, RuntimeError> addChild(const NameKey &key) const noexcept;
+
+    /**
+     * Appends `<name>text</name>`. The text is taken literally, like appendText().
+     */
+    [[nodiscard]] std::expected<Node, RuntimeError> addChild(std::string_view name,
+                                                             std::string_view text) const noexcept;
+
+    /**
+     * Appends one `<name>text</name>` child per (name, text) pair of `children`, in order.
+     */
+    template <std::ranges::input_range Children>
+        requires std::convertible_to<std::ranges::range_value_t<Children>,
+                                     std::pair<std::string_view, std::string_view>>
+    [[nodiscard]] std::expected<void, RuntimeError> addChildren(Children &&children) const noexcept
+    {
+        for (auto &&child : children)
+        {
+            const std::pair<std::string_view, std::string_view> element{child};
+            if (auto added = this->addChild(element.first, element.second); !added)
+                return std::unexpected{added.error()};
+        }
+        return {};
+    }
+
+    /**
+     * Sets the attribute `name`; an existing attribute of that name is removed and the new one appended. The value
+     * is taken literally.
+     */
+    [[nodiscard]] std::expected<void, RuntimeError> setAttribute(std::string_view name,
+                                                                 std::string_view value) const noexcept;
+
+    /**
+     * Appends `text` as a text node, merged with a directly preceding one. Unlike addValue() the text is taken
+     * literally: no entity references are substituted and nothing needs to be escaped.
+     */
+    [[nodiscard]] std::expected<void, RuntimeError> appendText(std::string_view text) const noexcept;
+
     void addValue(std::string_view value) const;
 
     void addNamespace(std::string_view prefix, std::string_view uri) const;
 
     void removeNamespace() const;
 };
-} // namespace cpplibxml2
\ No newline at end of file
+
+template <Convertible T>
+std::expected<T, ConversionError> Node::valueAs(const int base) const noexcept
+{
+    if (!this->handle)
+        return std::unexpected{ConversionError::NoValue};
+    if (const auto content = this->valueView())
+        return parseValue<T>(content.value(), base);
+
+    std::string buffer;
+    const auto content = this->valueView(buffer);
+    if (!content)
+        return std::unexpected{ConversionError::NoValue};
+    return parseValue<T>(content.value(), base);
+}
+
+template <Convertible T>
+std::expected<T, ConversionError> Node::attributeAs(const std::string_view name, const int base) const noexcept
+{
+    const auto value = this->attribute(name);
+    if (!value)
+        return std::unexpected{ConversionError::NoValue};
+    return parseValue<T>(value.value(), base);
+}
+
+template <Convertible T>
+std::expected<T, ConversionError> Node::attributeAs(const std::string_view name, const std::string_view nsUri,
+                                                    const int base) const noexcept
+{
+    const auto value = this->attribute(name, nsUri);
+    if (!value)
+        return std::unexpected{ConversionError::NoValue};
+    return parseValue<T>(value.value(), base);
+}
+
+static_assert(std::is_trivially_copyable_v<Node>, "Node must stay a trivially copyable handle");
+static_assert(sizeof(Node) == sizeof(void *), "Node must stay pointer-sized");
+
+/**
+ * Sorted snapshot of an element's attributes for repeated lookups on wide elements.
+ * Building costs one pass plus a sort; a lookup is then a binary search instead of a linear walk over the attribute
+ * list. Only worth it for elements with many attributes that are queried several times (see AttributeBench); for a
+ * handful of attributes Node::attribute() is faster. The index holds views into the document and is invalidated by
+ * any modification of the element's attributes.
+ */
+class AttributeIndex
+{
+  public:
+    struct Entry
+    {
+        std::string_view name;
+        std::string_view nsUri;
+        std::string_view value;
+    };
+
+    AttributeIndex() = default;
+
+    explicit AttributeIndex(Node node);
+
+    /**
+     * Look up by local name only. If several namespaces use the same local name, the one without a namespace (or
+     * else the smallest namespace URI) wins.
+     */
+    [[nodiscard]] std::optional<std::string_view> find(std::string_view name) const noexcept;
+    [[nodiscard]] std::optional<std::string_view> find(std::string_view name, std::string_view nsUri) const noexcept;
+
+    template <Convertible T>
+    [[nodiscard]] std::expected<T, ConversionError> as(const std::string_view name, const int base = 10) const noexcept
+    {
+        const auto value = this->find(name);
+        if (!value)
+            return std::unexpected{ConversionError::NoValue};
+        return parseValue<T>(value.value(), base);
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept;
+    [[nodiscard]] bool empty() const noexcept;
+
+  private:
+    std::vector<Entry> entries;
+};
+
+class NodeIterator
+{
+    _xmlNode *current = nullptr;
+    _xmlNode *origin = nullptr;
+    NodeAxis axis = NodeAxis::Children;
+
+    friend class NodeRange;
+
+    NodeIterator(const NodeAxis nodeAxis, _xmlNode *originNode) noexcept
+        : current(detail::first(nodeAxis, originNode)), origin(originNode), axis(nodeAxis)
+    {
+    }
+
+  public:
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Node;
+    using difference_type = std::ptrdiff_t;
+    using reference = Node;
+
+    NodeIterator() noexcept = default;
+
+    [[nodiscard]] Node operator*() const noexcept
+    {
+        return Node{current};
+    }
+
+    NodeIterator &operator++() noexcept
+    {
+        current = detail::next(axis, current, origin);
+        return *this;
+    }
+
+    NodeIterator operator++(int) noexcept
+    {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    [[nodiscard]] friend bool operator==(const NodeIterator &lhs, const NodeIterator &rhs) noexcept
+    {
+        return lhs.current == rhs.current;
+    }
+
+    [[nodiscard]] friend bool operator==(const NodeIterator &it, std::default_sentinel_t) noexcept
+    {
+        return it.current == nullptr;
+    }
+};
+
+class NodeRange : public std::ranges::view_interface<NodeRange>
+{
+    _xmlNode *origin = nullptr;
+    NodeAxis axis = NodeAxis::Children;
+
+  public:
+    NodeRange() noexcept = default;
+
+    NodeRange(const NodeAxis nodeAxis, _xmlNode *originNode) noexcept : origin(originNode), axis(nodeAxis)
+    {
+    }
+
+    [[nodiscard]] NodeIterator begin() const noexcept
+    {
+        return NodeIterator{axis, origin};
+    }
+
+    [[nodiscard]] std::default_sentinel_t end() const noexcept
+    {
+        return std::default_sentinel;
+    }
+};
+
+static_assert(std::forward_iterator<NodeIterator>);
+static_assert(std::ranges::view<NodeRange>);
+
+inline NodeRange Node::children() const noexcept
+{
+    return NodeRange{NodeAxis::Children, this->handle};
+}
+
+inline NodeRange Node::elements() const noexcept
+{
+    return NodeRange{NodeAxis::Elements, this->handle};
+}
+
+inline NodeRange Node::siblings() const noexcept
+{
+    return NodeRange{NodeAxis::Siblings, this->handle};
+}
+
+inline NodeRange Node::descendants() const noexcept
+{
+    return NodeRange{NodeAxis::Descendants, this->handle};
+}
+
+inline NodeRange Node::ancestors() const noexcept
+{
+    return NodeRange{NodeAxis::Ancestors, this->handle};
+}
+
+inline auto Node::elements(const NameKey &key) const
+{
+    return this->elements() | std::views::filter([key](const Node node) { return node.hasName(key); });
+}
+} // namespace cpplibxml2
+
+template <>
+inline constexpr bool std::ranges::enable_borrowed_range<cpplibxml2::NodeRange> = true;
\ No newline at end of file
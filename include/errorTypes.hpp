@@ -1,5 +1,6 @@
 #pragma once
 #include <stdexcept>
+#include <string_view>
 
 namespace cpplibxml2 {
 class RuntimeError final : public std::runtime_error
@@ -20,4 +21,35 @@ class InvalidArgument final : public std::invalid_argument
     {
     }
 };
+
+/**
+ * Failure reasons of the from_chars based value conversions.
+ * A plain enum so that reporting an error never allocates or throws.
+ */
+enum class ConversionError
+{
+    NoValue,       /* the node is null or has no text content */
+    Empty,         /* the text is empty or only whitespace */
+    InvalidFormat, /* the text is not entirely a value of the requested type */
+    OutOfRange,    /* the value does not fit into the requested type */
+    InvalidBase    /* the integer base is outside [2, 36] */
+};
+
+[[nodiscard]] constexpr std::string_view to_string(const ConversionError error) noexcept
+{
+    switch (error)
+    {
+    case ConversionError::NoValue:
+        return "Node has no value.";
+    case ConversionError::Empty:
+        return "Value is empty.";
+    case ConversionError::InvalidFormat:
+        return "Value has an invalid format.";
+    case ConversionError::OutOfRange:
+        return "Value is out of range.";
+    case ConversionError::InvalidBase:
+        return "Invalid base.";
+    }
+    return "Unknown conversion error.";
+}
 } // namespace cpplibxml2
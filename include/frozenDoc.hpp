@@ -0,0 +1,59 @@
+#pragma once
+
+#include "cpplibxml2.hpp"
+#include "xpath.hpp"
+
+namespace cpplibxml2
+{
+/**
+ * An immutable document that may be read from many threads at once.
+ *
+ * A plain Doc gives no guarantees for concurrent use: Doc::query keeps a cache and every Node exposes modifying
+ * functions. Moving a Doc into a FrozenDoc ends its mutable life. From then on the following are safe to call
+ * concurrently from any number of threads, on Nodes of this document:
+ *
+ *  - FrozenDoc::root, FrozenDoc::nameKey and FrozenDoc::query,
+ *  - Node::name, type, findChild, hasName, getChildren, the NodeRange views, value, valueView, valueAs and the
+ *    valueAsX family, findProperty, attribute, attributeAs, getProperties, getNamespace,
+ *  - AttributeIndex construction and lookups, and XPathResult access.
+ *
+ * Calling any modifying Node function (addChild, addValue, addNamespace, removeNamespace) on a node of a FrozenDoc is
+ * undefined behavior. libxml2 is initialized exactly once (see Doc::parse), so no global state is touched on the read
+ * paths; XPath evaluations use contexts from an internal pool, one per concurrent caller.
+ */
+class FrozenDoc
+{
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+
+  public:
+    explicit FrozenDoc(Doc &&doc);
+
+    FrozenDoc(const FrozenDoc &) = delete;
+
+    FrozenDoc(FrozenDoc &&) noexcept;
+
+    ~FrozenDoc();
+
+    FrozenDoc &operator=(const FrozenDoc &) = delete;
+
+    FrozenDoc &operator=(FrozenDoc &&) noexcept;
+
+    [[nodiscard]] std::expected<Node, RuntimeError> root() const noexcept;
+
+    [[nodiscard]] NameKey nameKey(std::string_view name) const;
+
+    /**
+     * Thread-safe counterpart of Doc::query; compiled expressions are cached and shared between threads, with the
+     * same bound as the Doc::query cache.
+     */
+    [[nodiscard]] std::expected<XPathResult, RuntimeError> query(std::string_view expression) const;
+
+    [[nodiscard]] std::expected<XPathResult, RuntimeError> query(std::string_view expression, Node context) const;
+
+    [[nodiscard]] std::expected<XPathResult, RuntimeError> query(const XPathExpression &expression) const;
+
+    [[nodiscard]] std::expected<XPathResult, RuntimeError> query(const XPathExpression &expression,
+                                                                 Node context) const;
+};
+} // namespace cpplibxml2
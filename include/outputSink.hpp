@@ -0,0 +1,56 @@
+#pragma once
+
+#include "cpplibxml2.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <span>
+
+namespace cpplibxml2
+{
+/**
+ * Destination for Doc::serialize and Node::serialize.
+ *
+ * Serialization goes through a libxml2 xmlOutputBuffer, which hands over the output in chunks of a few kilobytes as
+ * it is produced, so the complete document never exists in memory at once. A sink forwards these chunks to a
+ * callback, a std::ostream or a file descriptor. A sink created with a caller-owned buffer instead collects the
+ * output in that buffer and passes it on only when it is full (and once more at the end), so every chunk the callback
+ * sees is exactly `buffer.size()` bytes except the last one; the same buffer can be reused for any number of
+ * serializations.
+ *
+ * The callback returns false to abort the serialization, which then fails with a RuntimeError. Exceptions thrown by
+ * the callback or the stream are rethrown from serialize() once libxml2 has been cleaned up.
+ */
+class OutputSink
+{
+  public:
+    using Callback = std::function<bool(std::string_view chunk)>;
+
+    OutputSink(Callback callback);
+
+    OutputSink(std::ostream &stream);
+
+    OutputSink(std::span<char> buffer, Callback callback);
+
+    /**
+     * Writes to an already open file descriptor, retrying partial writes. The descriptor is not closed.
+     */
+    [[nodiscard]] static OutputSink fileDescriptor(int fd);
+
+    /**
+     * Passes `chunk` on, through the buffer if there is one. Returns false if the sink refused it.
+     */
+    [[nodiscard]] bool write(std::string_view chunk);
+
+    /**
+     * Passes on whatever is left in the buffer. Returns false if the sink refused it.
+     */
+    [[nodiscard]] bool flush();
+
+  private:
+    Callback callback;
+    std::span<char> buffer;
+    std::size_t used = 0;
+};
+} // namespace cpplibxml2
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "cpplibxml2.hpp"
+
+namespace cpplibxml2
+{
+namespace detail
+{
+/**
+ * @return The number of chunks the last ParallelParser call on this thread spliced into its Doc, 0 if the input was
+ *         parsed serially. For tests.
+ */
+[[nodiscard]] std::size_t lastChunkCount() noexcept;
+} // namespace detail
+
+/**
+ * Parses one large document of repeated records, <root><record>…</record><record>…</record>…</root>, on several
+ * threads.
+ *
+ * The body of the root element is cut into chunks just before record start tags, found by scanning ahead from evenly
+ * spaced positions and skipping candidates inside comments, CDATA sections and processing instructions. Every chunk
+ * is parsed on its own thread, wrapped in the original XML declaration and root start tag so that encoding and
+ * namespace declarations carry over, and the chunks' records are then spliced under one root. The result is the same
+ * tree Doc::parse builds.
+ *
+ * The cut points are a guess: one that lands in a nested record or in markup the scan misread makes the chunks on
+ * both sides fail, and they are parsed again as one. Inputs the split cannot handle are parsed serially with
+ * Doc::parse, which also reports errors of malformed documents: parsers with one thread, inputs smaller than a few
+ * chunks, documents with a DOCTYPE (whose entities and default attributes apply to the whole document) and documents
+ * with ID attributes. The chunks are parsed without ParserOptions::Recover, which would hide a bad cut; with it,
+ * malformed inputs end up in the serial parse, which recovers what it can.
+ *
+ * The resulting Doc has no name dictionary, see NameKey.
+ */
+class ParallelParser
+{
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+
+  public:
+    /**
+     * @param threads Number of threads, including the calling one; 0 uses std::thread::hardware_concurrency()
+     * @param options libxml2 parser options
+     */
+    explicit ParallelParser(std::size_t threads = 0,
+                            ParserOptions options = ParserOptions::NoEnt | ParserOptions::DtdLoad);
+
+    ParallelParser(const ParallelParser &) = delete;
+
+    ParallelParser(ParallelParser &&) noexcept;
+
+    ~ParallelParser();
+
+    ParallelParser &operator=(const ParallelParser &) = delete;
+
+    ParallelParser &operator=(ParallelParser &&) noexcept;
+
+    [[nodiscard]] std::size_t threads() const noexcept;
+
+    /**
+     * Chunks are at least this large, smaller inputs are parsed serially. Defaults to 1 MiB.
+     */
+    void setMinChunkSize(std::size_t bytes) noexcept;
+
+    /**
+     * @param recordName Qualified name of the record elements as written in the input, e.g. "ns2:Service"
+     */
+    [[nodiscard]] std::expected<Doc, RuntimeError> parse(std::string_view input, std::string_view recordName) const;
+
+    /**
+     * Parses a memory-mapped file, see Doc::parseMappedFile.
+     */
+    [[nodiscard]] std::expected<Doc, RuntimeError> parseFile(const std::filesystem::path &path,
+                                                             std::string_view recordName) const;
+};
+} // namespace cpplibxml2
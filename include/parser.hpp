@@ -0,0 +1,48 @@
+#pragma once
+
+#include "cpplibxml2.hpp"
+
+namespace cpplibxml2
+{
+/**
+ * Reusable parser context.
+ *
+ * Doc::parse and Doc::parseFile set up a fresh libxml2 parser context and name dictionary for every document. A
+ * Parser keeps both alive and only resets them between documents, which dominates the cost for small messages.
+ *
+ * A Parser must only be used by one thread at a time; Parser::local() hands out one instance per thread. Docs
+ * produced by the same Parser share its name dictionary: they can be read from any thread, but should be destroyed
+ * on the thread that owns the Parser or once that Parser is no longer parsing. The same goes for building on them
+ * with Doc::intern, Node::addChild or Node::setAttribute, which add names to that dictionary.
+ */
+class Parser
+{
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+
+  public:
+    Parser();
+
+    Parser(const Parser &) = delete;
+
+    Parser(Parser &&) noexcept;
+
+    ~Parser();
+
+    Parser &operator=(const Parser &) = delete;
+
+    Parser &operator=(Parser &&) noexcept;
+
+    /**
+     * The Parser owned by the calling thread.
+     */
+    [[nodiscard]] static Parser &local() noexcept;
+
+    [[nodiscard]] std::expected<Doc, RuntimeError> parse(std::string_view,
+                                                         ParserOptions options = ParserOptions::NoEnt |
+                                                                                 ParserOptions::DtdLoad) noexcept;
+
+    [[nodiscard]] std::expected<Doc, RuntimeError> parseFile(
+        const std::filesystem::path &, ParserOptions options = ParserOptions::NoEnt | ParserOptions::DtdLoad) noexcept;
+};
+} // namespace cpplibxml2
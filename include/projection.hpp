@@ -0,0 +1,61 @@
+#pragma once
+
+#include "cpplibxml2.hpp"
+
+#include <initializer_list>
+#include <span>
+
+namespace cpplibxml2
+{
+/**
+ * Parses documents into a Doc that holds only selected elements.
+ *
+ * A projection is a set of element paths from the root down, separated by '/', e.g. "catalog/book/price". A step is
+ *
+ *  - a local name, matching elements of that name in any namespace, like Node::findChild(name),
+ *  - "{uri}name", matching elements of that name in the namespace `uri`, like Node::findChild(name, nsUri); "{}name"
+ *    matches elements in no namespace,
+ *  - "*", matching any element.
+ *
+ * Elements a path selects are kept with their whole subtree. Their ancestors are kept with their attributes and
+ * namespace declarations, but without text, comments and other children. Everything else is dropped while parsing,
+ * before any node is built, so the parse is faster and the Doc a fraction of the size when few elements are needed.
+ * The root element is always kept. The whole input is still checked for well-formedness. The filter needs the SAX2
+ * interface, so ParserOptions::XML_PARSE_SAX1 is ignored.
+ *
+ * A Projection is immutable, parse() and parseFile() may be called from several threads at once.
+ */
+class Projection
+{
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+
+    Projection();
+
+  public:
+    Projection(const Projection &) = delete;
+
+    Projection(Projection &&) noexcept;
+
+    ~Projection();
+
+    Projection &operator=(const Projection &) = delete;
+
+    Projection &operator=(Projection &&) noexcept;
+
+    /**
+     * @return The projection, or an error if a path is empty or has an empty or malformed step
+     */
+    [[nodiscard]] static std::expected<Projection, RuntimeError> create(std::span<const std::string_view> paths);
+
+    [[nodiscard]] static std::expected<Projection, RuntimeError> create(
+        std::initializer_list<std::string_view> paths);
+
+    [[nodiscard]] std::expected<Doc, RuntimeError> parse(
+        std::string_view input, ParserOptions options = ParserOptions::NoEnt | ParserOptions::DtdLoad) const noexcept;
+
+    [[nodiscard]] std::expected<Doc, RuntimeError> parseFile(
+        const std::filesystem::path &path,
+        ParserOptions options = ParserOptions::NoEnt | ParserOptions::DtdLoad) const noexcept;
+};
+} // namespace cpplibxml2
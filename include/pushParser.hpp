@@ -0,0 +1,51 @@
+#pragma once
+
+#include "cpplibxml2.hpp"
+
+namespace cpplibxml2
+{
+/**
+ * Incremental parser for input that arrives in pieces, e.g. from a socket.
+ *
+ * Every chunk is parsed as soon as it is fed, so parsing overlaps with I/O and the input never has to be buffered
+ * as a whole. After finish() the parser is ready for the next document.
+ *
+ * A PushParser must only be used by one thread at a time. Docs produced by the same PushParser share its name
+ * dictionary: they can be read from any thread, but should be destroyed on the thread that owns the PushParser or
+ * once that PushParser is no longer parsing. The same goes for building on them with Doc::intern, Node::addChild or
+ * Node::setAttribute, which add names to that dictionary.
+ */
+class PushParser
+{
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+
+    PushParser();
+
+  public:
+    PushParser(const PushParser &) = delete;
+
+    PushParser(PushParser &&) noexcept;
+
+    ~PushParser();
+
+    PushParser &operator=(const PushParser &) = delete;
+
+    PushParser &operator=(PushParser &&) noexcept;
+
+    [[nodiscard]] static std::expected<PushParser, RuntimeError> create(
+        ParserOptions options = ParserOptions::NoEnt | ParserOptions::DtdLoad) noexcept;
+
+    /**
+     * Parses the next chunk of the document. The chunk is not referenced after the call returns.
+     *
+     * @return Success, or an error as soon as the input is known to be malformed (unless ParserOptions::Recover is set)
+     */
+    [[nodiscard]] std::expected<void, RuntimeError> feed(std::string_view chunk) noexcept;
+
+    /**
+     * Signals the end of the input and hands out the parsed document.
+     */
+    [[nodiscard]] std::expected<Doc, RuntimeError> finish() noexcept;
+};
+} // namespace cpplibxml2
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "cpplibxml2.hpp"
+
+#include <optional>
+
+namespace cpplibxml2
+{
+/**
+ * Node types reported by the Reader cursor, see xmlReaderTypes.
+ */
+enum class ReaderNodeType : int
+{
+    None = 0,
+    StartElement = 1,
+    Attribute = 2,
+    Text = 3,
+    CData = 4,
+    EntityReference = 5,
+    Entity = 6,
+    ProcessingInstruction = 7,
+    Comment = 8,
+    Document = 9,
+    DocumentType = 10,
+    DocumentFragment = 11,
+    Notation = 12,
+    Whitespace = 13,
+    SignificantWhitespace = 14,
+    EndElement = 15,
+    EndEntity = 16,
+    XmlDeclaration = 17
+};
+
+/**
+ * Forward-only pull parser backed by libxml2's xmlTextReader.
+ *
+ * Only the nodes around the cursor are kept in memory, so arbitrarily large documents can be processed with constant
+ * memory. All string_views returned by the accessors stay valid until the next call to read(), next() or one of the
+ * attribute movements; names are interned and stay valid for the lifetime of the Reader.
+ */
+class Reader
+{
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+
+    Reader();
+
+  public:
+    Reader(const Reader &) = delete;
+
+    Reader(Reader &&) noexcept;
+
+    ~Reader();
+
+    Reader &operator=(const Reader &) = delete;
+
+    Reader &operator=(Reader &&) noexcept;
+
+    [[nodiscard]] static std::expected<Reader, RuntimeError> openFile(
+        const std::filesystem::path &, ParserOptions options = ParserOptions::NoEnt | ParserOptions::DtdLoad) noexcept;
+
+    /**
+     * Reads from an in-memory buffer. The buffer is not copied and has to outlive the Reader.
+     */
+    [[nodiscard]] static std::expected<Reader, RuntimeError> open(std::string_view,
+                                                                  ParserOptions options = ParserOptions::NoEnt |
+                                                                                          ParserOptions::DtdLoad) noexcept;
+
+    /**
+     * Advances the cursor to the next node in document order.
+     *
+     * @return true if the cursor is on a node, false at the end of the document, or an error if the input is malformed
+     */
+    [[nodiscard]] std::expected<bool, RuntimeError> read() noexcept;
+
+    /**
+     * Advances the cursor to the next sibling, skipping the subtree of the current node.
+     */
+    [[nodiscard]] std::expected<bool, RuntimeError> next() noexcept;
+
+    [[nodiscard]] ReaderNodeType nodeType() const noexcept;
+
+    [[nodiscard]] int depth() const noexcept;
+
+    [[nodiscard]] bool isEmptyElement() const noexcept;
+
+    /**
+     * The qualified name of the current node, e.g. "ns2:Service".
+     */
+    [[nodiscard]] std::string_view name() const noexcept;
+
+    [[nodiscard]] std::string_view localName() const noexcept;
+
+    [[nodiscard]] std::string_view prefix() const noexcept;
+
+    [[nodiscard]] std::string_view namespaceUri() const noexcept;
+
+    /**
+     * The text of text, CDATA, comment and attribute nodes. Empty for elements.
+     */
+    [[nodiscard]] std::string_view value() const noexcept;
+
+    [[nodiscard]] int attributeCount() const noexcept;
+
+    /**
+     * Looks up an attribute of the current element without moving the cursor.
+     */
+    [[nodiscard]] std::optional<std::string_view> attribute(std::string_view name) const noexcept;
+
+    [[nodiscard]] std::optional<std::string_view> attribute(std::string_view name,
+                                                            std::string_view nsUri) const noexcept;
+
+    /**
+     * Attribute cursor: while positioned on an attribute, name() and value() describe the attribute.
+     * moveToElement() returns to the element that owns the attributes.
+     */
+    [[nodiscard]] bool moveToFirstAttribute() noexcept;
+
+    [[nodiscard]] bool moveToNextAttribute() noexcept;
+
+    bool moveToElement() noexcept;
+
+    /**
+     * Materializes the subtree of the current node inside the reader.
+     *
+     * The returned Node is only valid until the cursor moves past the subtree; use next() afterwards to continue
+     * with the following sibling.
+     */
+    [[nodiscard]] std::expected<Node, RuntimeError> expand() noexcept;
+
+    /**
+     * Copies the subtree of the current node into a standalone Doc whose root is the current element.
+     */
+    [[nodiscard]] std::expected<Doc, RuntimeError> expandDoc() noexcept;
+};
+} // namespace cpplibxml2
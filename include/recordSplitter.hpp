@@ -0,0 +1,131 @@
+#pragma once
+
+#include "cpplibxml2.hpp"
+
+#include <concepts>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace cpplibxml2
+{
+/**
+ * The order in which RecordSplitter hands out the results of parallel processing.
+ */
+enum class RecordOrder
+{
+    Unordered, /* as soon as a record is processed */
+    Ordered    /* in document order */
+};
+
+/**
+ * Splits feeds of the form <root><record>…</record><record>…</record>…</root> into one standalone Doc per record.
+ *
+ * A Reader (see reader.hpp) streams through the input, so only the record at hand is materialized and memory stays
+ * bounded however large the feed is; each record is then copied into a Doc of its own whose root is the record
+ * element, with the namespaces it uses from its ancestors declared on it. The Node API works on it as on any parsed
+ * document, and it is independent of the input and of all other records, so it can be processed and destroyed on
+ * any thread.
+ *
+ * Records are elements with the given local name (and namespace URI, if one is given) at any depth. Records nested
+ * in a record are part of the outer one.
+ */
+class RecordSplitter
+{
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+
+    RecordSplitter();
+
+  public:
+    /**
+     * Receives the index of the record in the input, counting from 0, and the record.
+     */
+    using Callback = std::function<void(std::size_t, Doc &&)>;
+
+    /**
+     * Type-erased second half of transform(): delivers one processed record.
+     */
+    using Delivery = std::move_only_function<void()>;
+
+    RecordSplitter(const RecordSplitter &) = delete;
+
+    RecordSplitter(RecordSplitter &&) noexcept;
+
+    ~RecordSplitter();
+
+    RecordSplitter &operator=(const RecordSplitter &) = delete;
+
+    RecordSplitter &operator=(RecordSplitter &&) noexcept;
+
+    /**
+     * @param recordName Local name of the record elements
+     * @param nsUri Namespace URI of the record elements; empty matches records in any namespace
+     */
+    [[nodiscard]] static std::expected<RecordSplitter, RuntimeError> openFile(
+        const std::filesystem::path &path, std::string_view recordName, std::string_view nsUri = {},
+        ParserOptions options = ParserOptions::NoEnt | ParserOptions::DtdLoad) noexcept;
+
+    /**
+     * Splits an in-memory buffer. The buffer is not copied and has to outlive the RecordSplitter.
+     */
+    [[nodiscard]] static std::expected<RecordSplitter, RuntimeError> open(
+        std::string_view input, std::string_view recordName, std::string_view nsUri = {},
+        ParserOptions options = ParserOptions::NoEnt | ParserOptions::DtdLoad) noexcept;
+
+    /**
+     * @return The next record, std::nullopt after the last one, or an error if the input is malformed
+     */
+    [[nodiscard]] std::expected<std::optional<Doc>, RuntimeError> next();
+
+    /**
+     * Passes every remaining record to `callback` on the calling thread.
+     *
+     * @return The number of records, or an error if the input is malformed. The records before the error have been
+     *         passed on, except for the last few: the parser works ahead of the record handed out, by up to a few
+     *         hundred bytes, and reports errors as soon as it hits them.
+     */
+    std::expected<std::size_t, RuntimeError> forEach(const Callback &callback);
+
+    /**
+     * Reads the remaining records on the calling thread and passes them to `callback` on `threads` worker threads.
+     *
+     * With RecordOrder::Unordered the callback runs concurrently on the workers. With RecordOrder::Ordered the calls
+     * are serialized and made in document order; they still overlap with reading the following records. Exceptions
+     * thrown by the callback stop the split and are rethrown.
+     *
+     * @param threads Number of worker threads; 0 uses std::thread::hardware_concurrency()
+     */
+    std::expected<std::size_t, RuntimeError> forEach(const Callback &callback, std::size_t threads, RecordOrder order);
+
+    /**
+     * Processes the remaining records concurrently on `threads` worker threads and hands the results to `deliver`.
+     *
+     * `process(index, Doc &&)` runs concurrently on the workers. `deliver(index, result)` calls are serialized and,
+     * with RecordOrder::Ordered, made in document order. At most a few records per worker are read ahead, so memory
+     * stays bounded even if one record takes long to process.
+     *
+     * @param threads Number of worker threads; 0 uses std::thread::hardware_concurrency()
+     */
+    template <typename Process, typename Deliver>
+        requires std::invocable<Process &, std::size_t, Doc &&> &&
+                 std::invocable<Deliver &, std::size_t, std::invoke_result_t<Process &, std::size_t, Doc &&>>
+    std::expected<std::size_t, RuntimeError> transform(std::size_t threads, RecordOrder order, Process process,
+                                                       Deliver deliver)
+    {
+        return this->dispatch(threads, order, [&process, &deliver](const std::size_t index, Doc &&record) -> Delivery {
+            return [&deliver, index, result = std::invoke(process, index, std::move(record))]() mutable {
+                std::invoke(deliver, index, std::move(result));
+            };
+        });
+    }
+
+  private:
+    /**
+     * Runs `process` on the workers and the Delivery it returns serialized, in the requested order.
+     */
+    std::expected<std::size_t, RuntimeError> dispatch(std::size_t threads, RecordOrder order,
+                                                      const std::function<Delivery(std::size_t, Doc &&)> &process);
+};
+} // namespace cpplibxml2
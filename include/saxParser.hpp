@@ -0,0 +1,133 @@
+#pragma once
+
+#include "cpplibxml2.hpp"
+
+#include <span>
+
+namespace cpplibxml2
+{
+/**
+ * Attribute of a start element event. All views point into parser memory and are only valid during the callback.
+ */
+struct SaxAttribute
+{
+    std::string_view localName;
+    std::string_view prefix;
+    std::string_view uri;
+    std::string_view value;
+};
+
+/**
+ * Namespace declared on a start element event.
+ */
+struct SaxNamespace
+{
+    std::string_view prefix;
+    std::string_view uri;
+};
+
+namespace detail
+{
+/**
+ * Type-erased callback table. A null entry means the event is not registered with libxml2 at all.
+ */
+struct SaxCallbacks
+{
+    void (*startDocument)(void *) = nullptr;
+    void (*endDocument)(void *) = nullptr;
+    void (*startElement)(void *, std::string_view, std::string_view, std::string_view, std::span<const SaxNamespace>,
+                         std::span<const SaxAttribute>) = nullptr;
+    void (*endElement)(void *, std::string_view, std::string_view, std::string_view) = nullptr;
+    void (*characters)(void *, std::string_view) = nullptr;
+    void (*cdata)(void *, std::string_view) = nullptr;
+    void (*comment)(void *, std::string_view) = nullptr;
+    void (*processingInstruction)(void *, std::string_view, std::string_view) = nullptr;
+};
+
+[[nodiscard]] std::expected<void, RuntimeError> saxParse(std::string_view input, const SaxCallbacks &callbacks,
+                                                         void *handler, ParserOptions options) noexcept;
+
+[[nodiscard]] std::expected<void, RuntimeError> saxParseFile(const std::filesystem::path &path,
+                                                             const SaxCallbacks &callbacks, void *handler,
+                                                             ParserOptions options) noexcept;
+} // namespace detail
+
+/**
+ * Event based SAX2 parser.
+ *
+ * The Handler may define any subset of the following members; only the ones it defines are registered with libxml2,
+ * so events without a callback cost nothing:
+ *
+ *     void onStartDocument();
+ *     void onEndDocument();
+ *     void onStartElement(std::string_view localName, std::string_view prefix, std::string_view uri,
+ *                         std::span<const SaxNamespace> namespaces, std::span<const SaxAttribute> attributes);
+ *     void onEndElement(std::string_view localName, std::string_view prefix, std::string_view uri);
+ *     void onCharacters(std::string_view text);
+ *     void onCData(std::string_view text);
+ *     void onComment(std::string_view text);
+ *     void onProcessingInstruction(std::string_view target, std::string_view data);
+ *
+ * All string_views point into parser memory and are only valid during the callback. Text may be delivered in
+ * several consecutive onCharacters calls. Callbacks must not throw.
+ */
+template <typename Handler>
+class SaxParser
+{
+    [[nodiscard]] static consteval detail::SaxCallbacks callbacks() noexcept
+    {
+        detail::SaxCallbacks result;
+        if constexpr (requires(Handler &h) { h.onStartDocument(); })
+            result.startDocument = [](void *h) { static_cast<Handler *>(h)->onStartDocument(); };
+        if constexpr (requires(Handler &h) { h.onEndDocument(); })
+            result.endDocument = [](void *h) { static_cast<Handler *>(h)->onEndDocument(); };
+        if constexpr (requires(Handler &h, std::string_view s, std::span<const SaxNamespace> ns,
+                               std::span<const SaxAttribute> attrs) { h.onStartElement(s, s, s, ns, attrs); })
+            result.startElement = [](void *h, std::string_view localName, std::string_view prefix,
+                                     std::string_view uri, std::span<const SaxNamespace> namespaces,
+                                     std::span<const SaxAttribute> attributes) {
+                static_cast<Handler *>(h)->onStartElement(localName, prefix, uri, namespaces, attributes);
+            };
+        if constexpr (requires(Handler &h, std::string_view s) { h.onEndElement(s, s, s); })
+            result.endElement = [](void *h, std::string_view localName, std::string_view prefix,
+                                   std::string_view uri) {
+                static_cast<Handler *>(h)->onEndElement(localName, prefix, uri);
+            };
+        if constexpr (requires(Handler &h, std::string_view s) { h.onCharacters(s); })
+            result.characters = [](void *h, std::string_view text) { static_cast<Handler *>(h)->onCharacters(text); };
+        if constexpr (requires(Handler &h, std::string_view s) { h.onCData(s); })
+            result.cdata = [](void *h, std::string_view text) { static_cast<Handler *>(h)->onCData(text); };
+        if constexpr (requires(Handler &h, std::string_view s) { h.onComment(s); })
+            result.comment = [](void *h, std::string_view text) { static_cast<Handler *>(h)->onComment(text); };
+        if constexpr (requires(Handler &h, std::string_view s) { h.onProcessingInstruction(s, s); })
+            result.processingInstruction = [](void *h, std::string_view target, std::string_view data) {
+                static_cast<Handler *>(h)->onProcessingInstruction(target, data);
+            };
+        return result;
+    }
+
+    static constexpr detail::SaxCallbacks table = callbacks();
+
+  public:
+    SaxParser() = delete;
+
+    /**
+     * Parses the input and reports the events to the handler.
+     *
+     * @return Success, or an error if the document is not well-formed (unless ParserOptions::Recover is set)
+     */
+    [[nodiscard]] static std::expected<void, RuntimeError> parse(
+        const std::string_view input, Handler &handler,
+        const ParserOptions options = ParserOptions::NoEnt | ParserOptions::DtdLoad) noexcept
+    {
+        return detail::saxParse(input, table, std::addressof(handler), options);
+    }
+
+    [[nodiscard]] static std::expected<void, RuntimeError> parseFile(
+        const std::filesystem::path &path, Handler &handler,
+        const ParserOptions options = ParserOptions::NoEnt | ParserOptions::DtdLoad) noexcept
+    {
+        return detail::saxParseFile(path, table, std::addressof(handler), options);
+    }
+};
+} // namespace cpplibxml2
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace cpplibxml2
+{
+/**
+ * Whether the library was built with the CPPLIBXML2_ENABLE_STATS option. Without it the instrumentation is
+ * compiled out entirely and statsSnapshot() always returns zeros.
+ */
+#ifdef CPPLIBXML2_ENABLE_STATS
+inline constexpr bool statsEnabled = true;
+#else
+inline constexpr bool statsEnabled = false;
+#endif
+
+/**
+ * Distribution of call durations on a logarithmic scale.
+ */
+struct DurationHistogram
+{
+    /**
+     * Bucket 0 counts calls shorter than 2 ns, bucket i > 0 those taking [2^i, 2^(i+1)) ns; the last bucket also
+     * takes everything longer.
+     */
+    static constexpr std::size_t bucketCount = 40;
+
+    std::array<std::uint64_t, bucketCount> buckets{};
+    std::uint64_t count = 0;
+    std::uint64_t totalNanoseconds = 0;
+};
+
+/**
+ * Counters collected by the library since start-up or the last resetStats().
+ */
+struct Stats
+{
+    /* Doc::parse, parseFile, parseMappedFile, parseInArena and the Parser functions */
+    std::uint64_t parseCalls = 0;
+    std::uint64_t parseFailures = 0;
+    std::uint64_t bytesParsed = 0;
+    /* nodes stepped over by findChild, getChildren, the value functions and the NodeRange views, and attributes by
+       findProperty, attribute, getProperties and AttributeIndex */
+    std::uint64_t nodesVisited = 0;
+    /* Node handles returned by root, findChild, getChildren and addChild; the NodeRange views are not counted */
+    std::uint64_t nodeHandles = 0;
+    /* text copied by value(), valueView(std::string &) and the valueAsX family */
+    std::uint64_t valueCopies = 0;
+    std::uint64_t valueBytesCopied = 0;
+    /* Doc::dump, saveToFile and serialize, Node::serialize */
+    std::uint64_t serializeCalls = 0;
+    /* output of the serialize calls and of Writer */
+    std::uint64_t serializedBytes = 0;
+
+    DurationHistogram parseTime;
+    DurationHistogram serializeTime;
+};
+
+/**
+ * Collects the counters of all threads. Every thread counts into its own storage, so the instrumentation does not
+ * add contention; the snapshot is not atomic across counters while other threads keep working.
+ */
+[[nodiscard]] Stats statsSnapshot() noexcept;
+
+/**
+ * Starts counting from zero again, for all threads.
+ */
+void resetStats() noexcept;
+} // namespace cpplibxml2
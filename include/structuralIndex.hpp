@@ -0,0 +1,105 @@
+#pragma once
+
+#include "errorTypes.hpp"
+
+#include <cstddef>
+#include <expected>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace cpplibxml2
+{
+/**
+ * Instruction sets StructuralIndex can scan with.
+ */
+enum class SimdLevel
+{
+    Scalar, /* one byte at a time */
+    Sse2,   /* 16 bytes at a time, x86-64 */
+    Avx2    /* 32 bytes at a time, x86-64 */
+};
+
+/**
+ * Element positions of an XML buffer, found without parsing it.
+ *
+ * Building the index takes two passes. The first collects the offsets of all '<', '>', '"' and '\'' characters,
+ * comparing 16 or 32 bytes at once where the CPU supports it (see SimdLevel). The second walks only these offsets:
+ * it skips comments, CDATA sections, processing instructions, the DOCTYPE and quoted attribute values, and matches
+ * start and end tags. Both are much faster than a parse, which makes the index a cheap way to jump to the few
+ * elements a skimming reader needs, e.g. to parse only those with Doc::parse. To process every record of a feed use
+ * RecordSplitter instead: a parse per record costs more than the scan saves.
+ *
+ * The index checks no more than the tag structure: names, attributes, entity references and encodings are not
+ * validated, and an input the index accepts can still be rejected by the parser. The index holds views into the
+ * input, which has to outlive it.
+ */
+class StructuralIndex
+{
+  public:
+    struct Element
+    {
+        std::size_t begin;     /* offset of the '<' of the start tag */
+        std::size_t end;       /* offset after the '>' of the end tag, or of the start tag if it is empty */
+        std::size_t depth;     /* 0 for the root element */
+        std::string_view name; /* qualified name as written, e.g. "ns2:Service" */
+
+        [[nodiscard]] std::string_view text(const std::string_view input) const noexcept
+        {
+            return input.substr(this->begin, this->end - this->begin);
+        }
+    };
+
+  private:
+    std::vector<std::size_t> structuralOffsets;
+    std::vector<Element> elementList;
+    SimdLevel usedLevel = SimdLevel::Scalar;
+
+    StructuralIndex() = default;
+
+  public:
+    /**
+     * @return The fastest level the running CPU supports
+     */
+    [[nodiscard]] static SimdLevel supportedLevel() noexcept;
+
+    /**
+     * @return The index, or an error if comments, CDATA sections, processing instructions or tags are unterminated
+     *         or start and end tags do not match
+     */
+    [[nodiscard]] static std::expected<StructuralIndex, RuntimeError> build(std::string_view input);
+
+    /**
+     * Builds the index with the given level, or with supportedLevel() if the CPU lacks it. For tests and
+     * benchmarks.
+     */
+    [[nodiscard]] static std::expected<StructuralIndex, RuntimeError> build(std::string_view input, SimdLevel level);
+
+    [[nodiscard]] SimdLevel level() const noexcept
+    {
+        return this->usedLevel;
+    }
+
+    /**
+     * @return Ascending offsets of every '<', '>', '"' and '\'' in the input, including those in text and comments
+     */
+    [[nodiscard]] std::span<const std::size_t> structurals() const noexcept
+    {
+        return this->structuralOffsets;
+    }
+
+    /**
+     * @return All elements in document order
+     */
+    [[nodiscard]] std::span<const Element> elements() const noexcept
+    {
+        return this->elementList;
+    }
+
+    /**
+     * @return The elements with the qualified name `name` that are not nested in another one of that name, in
+     *         document order. Records nested in a record are part of the outer one, as in RecordSplitter.
+     */
+    [[nodiscard]] std::vector<Element> records(std::string_view name) const;
+};
+} // namespace cpplibxml2
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "cpplibxml2.hpp"
+#include "outputSink.hpp"
+
+namespace cpplibxml2
+{
+/**
+ * Forward-only XML writer backed by libxml2's xmlTextWriter.
+ *
+ * Output is escaped, encoded and passed to the file or sink in chunks of a few kilobytes as it is written; only the
+ * names of the currently open elements are kept, so documents of any size are produced with constant memory. This is
+ * the counterpart of Reader: use it instead of building a Doc with Node::addChild when the tree is only built to be
+ * saved.
+ *
+ * Every operation returns an error once the output failed, and after finish(). Exceptions thrown by a sink are
+ * rethrown from the operation during which libxml2 flushed to it.
+ */
+class Writer
+{
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+
+    Writer();
+
+  public:
+    Writer(const Writer &) = delete;
+
+    Writer(Writer &&) noexcept;
+
+    /**
+     * Flushes what has been written so far without closing open elements; call finish() to complete the document.
+     */
+    ~Writer();
+
+    Writer &operator=(const Writer &) = delete;
+
+    Writer &operator=(Writer &&) noexcept;
+
+    /**
+     * @param addWhiteSpaces If true, adds indentation and line breaks
+     */
+    [[nodiscard]] static std::expected<Writer, RuntimeError> toFile(const std::filesystem::path &path,
+                                                                    bool addWhiteSpaces = false) noexcept;
+
+    [[nodiscard]] static std::expected<Writer, RuntimeError> toSink(OutputSink sink,
+                                                                    bool addWhiteSpaces = false) noexcept;
+
+    /**
+     * Writes the XML declaration. The output is encoded in `format`; without a declaration it is UTF-8.
+     */
+    [[nodiscard]] std::expected<void, RuntimeError> startDocument(Format format = Format::UTF_8);
+
+    /**
+     * Closes all open elements and flushes the output.
+     */
+    [[nodiscard]] std::expected<void, RuntimeError> endDocument();
+
+    [[nodiscard]] std::expected<void, RuntimeError> startElement(std::string_view name);
+
+    /**
+     * Starts a namespaced element. A non-empty `nsUri` also declares `prefix` (or the default namespace if `prefix` is
+     * empty) on the element.
+     */
+    [[nodiscard]] std::expected<void, RuntimeError> startElement(std::string_view prefix, std::string_view name,
+                                                                 std::string_view nsUri);
+
+    [[nodiscard]] std::expected<void, RuntimeError> endElement();
+
+    /**
+     * Writes `<name>text</name>` in one go.
+     */
+    [[nodiscard]] std::expected<void, RuntimeError> element(std::string_view name, std::string_view text);
+
+    /**
+     * Attributes have to follow startElement() or another attribute directly.
+     */
+    [[nodiscard]] std::expected<void, RuntimeError> attribute(std::string_view name, std::string_view value);
+
+    [[nodiscard]] std::expected<void, RuntimeError> attribute(std::string_view prefix, std::string_view name,
+                                                              std::string_view nsUri, std::string_view value);
+
+    /**
+     * Declares `prefix` (the default namespace if empty) on the current element.
+     */
+    [[nodiscard]] std::expected<void, RuntimeError> addNamespace(std::string_view prefix, std::string_view uri);
+
+    [[nodiscard]] std::expected<void, RuntimeError> text(std::string_view text);
+
+    [[nodiscard]] std::expected<void, RuntimeError> cdata(std::string_view text);
+
+    [[nodiscard]] std::expected<void, RuntimeError> comment(std::string_view text);
+
+    /**
+     * Passes everything written so far on to the file or sink.
+     */
+    [[nodiscard]] std::expected<void, RuntimeError> flush();
+
+    /**
+     * Ends the document if it was started, flushes and closes the output. The Writer cannot be used afterwards.
+     */
+    [[nodiscard]] std::expected<void, RuntimeError> finish();
+};
+} // namespace cpplibxml2
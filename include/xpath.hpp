@@ -0,0 +1,214 @@
+#pragma once
+
+#include "cpplibxml2.hpp"
+
+#include <iterator>
+#include <utility>
+
+namespace cpplibxml2
+{
+/**
+ * Kinds of XPath results, see xmlXPathObjectType.
+ */
+enum class XPathResultType : int
+{
+    Undefined = 0,
+    NodeSet = 1,
+    Boolean = 2,
+    Number = 3,
+    String = 4
+};
+
+/**
+ * An XPath expression compiled once with xmlXPathCompile.
+ *
+ * Compiled expressions do not refer to any document, so one instance can be evaluated against any number of
+ * documents and contexts. Evaluating the same expression from several threads at once is safe as long as each thread
+ * uses its own XPathContext.
+ */
+class XPathExpression
+{
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+
+    XPathExpression();
+
+    friend class XPathContext;
+
+  public:
+    XPathExpression(const XPathExpression &) = delete;
+
+    XPathExpression(XPathExpression &&) noexcept;
+
+    ~XPathExpression();
+
+    XPathExpression &operator=(const XPathExpression &) = delete;
+
+    XPathExpression &operator=(XPathExpression &&) noexcept;
+
+    [[nodiscard]] static std::expected<XPathExpression, RuntimeError> compile(std::string_view expression) noexcept;
+};
+
+class XPathNodeIterator
+{
+    _xmlNode *const *current = nullptr;
+
+    friend class XPathResult;
+
+    explicit XPathNodeIterator(_xmlNode *const *position) noexcept : current(position)
+    {
+    }
+
+  public:
+    using value_type = Node;
+    using reference = Node;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+    using iterator_concept = std::forward_iterator_tag;
+
+    XPathNodeIterator() = default;
+
+    [[nodiscard]] Node operator*() const noexcept
+    {
+        return Node{*this->current};
+    }
+
+    XPathNodeIterator &operator++() noexcept
+    {
+        ++this->current;
+        return *this;
+    }
+
+    XPathNodeIterator operator++(int) noexcept
+    {
+        auto previous = *this;
+        ++*this;
+        return previous;
+    }
+
+    [[nodiscard]] friend bool operator==(const XPathNodeIterator &, const XPathNodeIterator &) noexcept = default;
+};
+
+static_assert(std::forward_iterator<XPathNodeIterator>);
+
+/**
+ * The result of an XPath evaluation.
+ *
+ * Node-set results are exposed as a range over the nodes libxml2 collected, nothing is copied into a vector. The
+ * nodes belong to the evaluated document, so a result must not outlive its Doc. Namespace nodes (`namespace::*`)
+ * are not nodes of the document in libxml2 and are left out of the range and of size(); boolean(), number() and
+ * string() still see them.
+ */
+class XPathResult
+{
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+
+    XPathResult();
+
+    friend class XPathContext;
+
+  public:
+    XPathResult(const XPathResult &) = delete;
+
+    XPathResult(XPathResult &&) noexcept;
+
+    ~XPathResult();
+
+    XPathResult &operator=(const XPathResult &) = delete;
+
+    XPathResult &operator=(XPathResult &&) noexcept;
+
+    [[nodiscard]] XPathResultType type() const noexcept;
+
+    /**
+     * Node-set access. Results of another type behave like an empty node-set.
+     */
+    [[nodiscard]] XPathNodeIterator begin() const noexcept;
+    [[nodiscard]] XPathNodeIterator end() const noexcept;
+    [[nodiscard]] std::size_t size() const noexcept;
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * The result converted with the XPath boolean(), number() and string() functions.
+     */
+    [[nodiscard]] bool boolean() const noexcept;
+    [[nodiscard]] double number() const noexcept;
+    [[nodiscard]] std::string string() const;
+};
+
+/**
+ * Reusable XPath evaluation context.
+ *
+ * Creating a libxml2 XPath context allocates and registers all built-in functions, so keep one per thread and switch
+ * it between documents with setDocument() instead of creating one per evaluation. Registered namespaces survive
+ * setDocument().
+ */
+class XPathContext
+{
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+
+    XPathContext();
+
+  public:
+    XPathContext(const XPathContext &) = delete;
+
+    XPathContext(XPathContext &&) noexcept;
+
+    ~XPathContext();
+
+    XPathContext &operator=(const XPathContext &) = delete;
+
+    XPathContext &operator=(XPathContext &&) noexcept;
+
+    [[nodiscard]] static std::expected<XPathContext, RuntimeError> create(const Doc &doc) noexcept;
+
+    void setDocument(const Doc &doc) noexcept;
+
+    /**
+     * Binds `prefix` to `uri` for use in expressions. XPath 1.0 has no default namespace, so elements in a default
+     * namespace have to be addressed through a prefix registered here.
+     */
+    [[nodiscard]] std::expected<void, RuntimeError> registerNamespace(std::string_view prefix,
+                                                                      std::string_view uri) noexcept;
+
+    /**
+     * Registers (prefix, uri) pairs as returned by Node::getNamespace().
+     */
+    template <std::ranges::input_range Namespaces>
+        requires std::convertible_to<std::ranges::range_value_t<Namespaces>,
+                                     std::pair<std::string_view, std::string_view>>
+    [[nodiscard]] std::expected<void, RuntimeError> registerNamespaces(Namespaces &&namespaces) noexcept
+    {
+        for (auto &&ns : namespaces)
+        {
+            const std::pair<std::string_view, std::string_view> binding{ns};
+            if (auto result = this->registerNamespace(binding.first, binding.second); !result)
+                return result;
+        }
+        return {};
+    }
+
+    /**
+     * Registers every prefixed namespace declaration in scope at `node`; nearer declarations win.
+     */
+    [[nodiscard]] std::expected<void, RuntimeError> registerNamespaces(Node node) noexcept;
+
+    /**
+     * Evaluates relative to the document node.
+     */
+    [[nodiscard]] std::expected<XPathResult, RuntimeError> evaluate(const XPathExpression &expression) noexcept;
+
+    [[nodiscard]] std::expected<XPathResult, RuntimeError> evaluate(const XPathExpression &expression,
+                                                                    Node context) noexcept;
+
+    /**
+     * Compiles and evaluates in one go; prefer a precompiled XPathExpression for anything evaluated repeatedly.
+     */
+    [[nodiscard]] std::expected<XPathResult, RuntimeError> evaluate(std::string_view expression) noexcept;
+
+    [[nodiscard]] std::expected<XPathResult, RuntimeError> evaluate(std::string_view expression,
+                                                                    Node context) noexcept;
+};
+} // namespace cpplibxml2
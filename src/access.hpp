@@ -0,0 +1,136 @@
+#pragma once
+
+#include "cpplibxml2.hpp"
+#include "arena.hpp"
+#include "helper.hpp"
+#include "xpath.hpp"
+
+#include <libxml/tree.h>
+
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace cpplibxml2
+{
+namespace detail
+{
+struct StringHash
+{
+    using is_transparent = void;
+
+    [[nodiscard]] std::size_t operator()(const std::string_view in) const noexcept
+    {
+        return std::hash<std::string_view>{}(in);
+    }
+};
+
+/**
+ * Compiled XPath expressions by their text, evicting the least recently used. Bounded, because queries built from
+ * data, like //book[@id='…'], would otherwise grow it for the lifetime of the document. Expressions are shared, so one
+ * that is being evaluated survives its eviction. Not synchronized.
+ */
+class ExpressionCache
+{
+    using Entry = std::pair<std::string, std::shared_ptr<const XPathExpression>>;
+
+    // Most recently used first; the index keys view the strings of the entries, which list nodes keep in place.
+    std::list<Entry> entries;
+    std::unordered_map<std::string_view, std::list<Entry>::iterator, StringHash, std::equal_to<>> index;
+
+  public:
+    static constexpr std::size_t capacity = 64;
+
+    [[nodiscard]] std::shared_ptr<const XPathExpression> find(const std::string_view text)
+    {
+        const auto it = this->index.find(text);
+        if (it == this->index.end())
+            return nullptr;
+        this->entries.splice(this->entries.begin(), this->entries, it->second);
+        return it->second->second;
+    }
+
+    /**
+     * @return The cached expression for `text`, which is `expression` unless one was cached in the meantime
+     */
+    std::shared_ptr<const XPathExpression> insert(const std::string_view text, XPathExpression &&expression)
+    {
+        if (auto cached = this->find(text))
+            return cached;
+        if (this->entries.size() == capacity)
+        {
+            this->index.erase(this->entries.back().first);
+            this->entries.pop_back();
+        }
+        this->entries.emplace_front(std::string{text}, std::make_shared<const XPathExpression>(std::move(expression)));
+        this->index.emplace(this->entries.front().first, this->entries.begin());
+        return this->entries.front().second;
+    }
+};
+
+/**
+ * Lazily created state behind Doc::query.
+ */
+struct XPathCache
+{
+    ExpressionCache expressions;
+    std::optional<XPathContext> context;
+};
+} // namespace detail
+
+struct Doc::Impl
+{
+#ifdef CPPLIBXML2_ENABLE_ARENA
+    // Set for documents from Doc::parseInArena: the arena owns all of the document's memory.
+    std::unique_ptr<detail::Arena> arena;
+#endif
+    xmlDocPtr_t doc;
+    // Declared after doc so the context is released before the document it points to.
+    std::unique_ptr<detail::XPathCache> xpath;
+
+#ifdef CPPLIBXML2_ENABLE_ARENA
+    ~Impl()
+    {
+        if (this->arena)
+        {
+            // Teardown is releasing the arena, skip walking the tree with xmlFreeDoc.
+            this->xpath.reset();
+            (void)this->doc.release();
+        }
+    }
+#endif
+};
+
+namespace detail
+{
+/**
+ * Library-internal bridge between the public handles and the libxml2 pointers they wrap.
+ */
+struct Access
+{
+    [[nodiscard]] static Doc makeDoc(xmlDocPtr_t doc)
+    {
+        auto result = Doc{};
+        result.impl->doc = std::move(doc);
+        return result;
+    }
+
+    [[nodiscard]] static xmlDocPtr raw(const Doc &doc) noexcept
+    {
+        return doc.impl->doc.get();
+    }
+
+    [[nodiscard]] static Node makeNode(xmlNodePtr node) noexcept
+    {
+        return Node{node};
+    }
+
+    [[nodiscard]] static xmlNodePtr raw(const Node node) noexcept
+    {
+        return node.handle;
+    }
+};
+} // namespace detail
+} // namespace cpplibxml2
@@ -0,0 +1,231 @@
+#include "arena.hpp"
+
+#ifdef CPPLIBXML2_ENABLE_ARENA
+
+#include <libxml/xmlmemory.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+namespace cpplibxml2::detail
+{
+namespace
+{
+// Chunks are aligned to their granule so the owning granule of any pointer is found by masking.
+constexpr std::size_t granuleShift = 20;
+constexpr std::size_t granule = std::size_t{1} << granuleShift;
+
+// Every arena block is preceded by its size, which realloc needs to copy the old contents.
+constexpr std::size_t headerSize = alignof(std::max_align_t);
+
+/**
+ * Insert-only set of granule numbers that belong to arena chunks. Lookups are lock-free; inserts happen under the
+ * pool mutex. Entries are never removed because chunks are never returned to the system.
+ */
+class GranuleSet
+{
+    static constexpr std::size_t capacity = std::size_t{1} << 16; // 64 GiB of arena memory
+
+    std::array<std::atomic<std::uintptr_t>, capacity> slots{};
+
+    static std::size_t slotOf(const std::uintptr_t key) noexcept
+    {
+        return static_cast<std::size_t>(key * 0x9E3779B97F4A7C15ull) & (capacity - 1);
+    }
+
+  public:
+    [[nodiscard]] bool insert(const std::uintptr_t key) noexcept
+    {
+        for (auto slot = slotOf(key), probes = std::size_t{0}; probes < capacity;
+             slot = (slot + 1) & (capacity - 1), ++probes)
+        {
+            const auto current = this->slots[slot].load(std::memory_order_relaxed);
+            if (current == key)
+                return true;
+            if (current == 0)
+            {
+                this->slots[slot].store(key, std::memory_order_release);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    [[nodiscard]] bool contains(const std::uintptr_t key) const noexcept
+    {
+        for (auto slot = slotOf(key), probes = std::size_t{0}; probes < capacity;
+             slot = (slot + 1) & (capacity - 1), ++probes)
+        {
+            const auto current = this->slots[slot].load(std::memory_order_acquire);
+            if (current == key)
+                return true;
+            if (current == 0)
+                return false;
+        }
+        return false;
+    }
+};
+
+struct ChunkPool
+{
+    std::mutex mutex;
+    std::vector<std::pair<std::byte *, std::size_t>> idle;
+    GranuleSet granules;
+};
+
+ChunkPool &pool() noexcept
+{
+    static ChunkPool instance;
+    return instance;
+}
+
+thread_local Arena *current = nullptr;
+
+[[nodiscard]] std::uintptr_t granuleOf(const void *ptr) noexcept
+{
+    // Granule 0 never holds a chunk, so 0 can mark empty slots.
+    return reinterpret_cast<std::uintptr_t>(ptr) >> granuleShift;
+}
+
+[[nodiscard]] bool isArenaMemory(const void *ptr) noexcept
+{
+    return ptr && pool().granules.contains(granuleOf(ptr));
+}
+
+std::pair<std::byte *, std::size_t> acquireChunk(const std::size_t minimum) noexcept
+{
+    auto &chunks = pool();
+    const std::lock_guard lock{chunks.mutex};
+    if (const auto it = std::ranges::find_if(chunks.idle, [minimum](const auto &chunk) { return chunk.second >= minimum; });
+        it != chunks.idle.end())
+    {
+        const auto chunk = *it;
+        chunks.idle.erase(it);
+        return chunk;
+    }
+
+    const auto size = (minimum + granule - 1) & ~(granule - 1);
+    const auto data = static_cast<std::byte *>(std::aligned_alloc(granule, size));
+    if (!data)
+        return {nullptr, 0};
+    for (auto offset = std::size_t{0}; offset < size; offset += granule)
+    {
+        if (!chunks.granules.insert(granuleOf(data + offset)))
+        {
+            // Granule table is full; the chunk stays unregistered and is released again.
+            std::free(data);
+            return {nullptr, 0};
+        }
+    }
+    return {data, size};
+}
+
+void releaseChunks(const std::vector<std::pair<std::byte *, std::size_t>> &released)
+{
+    auto &chunks = pool();
+    const std::lock_guard lock{chunks.mutex};
+    chunks.idle.insert(chunks.idle.end(), released.begin(), released.end());
+}
+
+[[nodiscard]] std::size_t blockSize(const void *ptr) noexcept
+{
+    std::size_t size;
+    std::memcpy(&size, static_cast<const std::byte *>(ptr) - headerSize, sizeof(size));
+    return size;
+}
+
+void *arenaMalloc(const std::size_t size)
+{
+    if (current)
+        return current->allocate(size);
+    return std::malloc(size);
+}
+
+void arenaFree(void *ptr)
+{
+    // Arena memory is released together with its arena.
+    if (!isArenaMemory(ptr))
+        std::free(ptr);
+}
+
+void *arenaRealloc(void *ptr, const std::size_t size)
+{
+    if (!isArenaMemory(ptr))
+        return std::realloc(ptr, size);
+
+    const auto oldSize = blockSize(ptr);
+    if (size <= oldSize)
+        return ptr;
+    const auto moved = arenaMalloc(size);
+    if (moved)
+        std::memcpy(moved, ptr, oldSize);
+    return moved;
+}
+
+char *arenaStrdup(const char *str)
+{
+    const auto size = std::strlen(str) + 1;
+    const auto copy = static_cast<char *>(arenaMalloc(size));
+    if (copy)
+        std::memcpy(copy, str, size);
+    return copy;
+}
+} // namespace
+
+Arena::~Arena()
+{
+    std::vector<std::pair<std::byte *, std::size_t>> released;
+    released.reserve(this->chunks.size());
+    for (const auto &chunk : this->chunks)
+        released.emplace_back(chunk.data, chunk.size);
+    releaseChunks(released);
+}
+
+void *Arena::allocate(const std::size_t size) noexcept
+{
+    const auto needed = headerSize + ((size + headerSize - 1) & ~(headerSize - 1));
+    if (static_cast<std::size_t>(this->limit - this->cursor) < needed)
+    {
+        const auto [data, chunkSize] = acquireChunk(needed);
+        if (!data)
+            return nullptr;
+        this->chunks.push_back({data, chunkSize});
+        this->cursor = data;
+        this->limit = data + chunkSize;
+    }
+
+    const auto block = this->cursor;
+    std::memcpy(block, &size, sizeof(size));
+    this->cursor += needed;
+    this->used += needed;
+    return block + headerSize;
+}
+
+std::size_t Arena::bytesUsed() const noexcept
+{
+    return this->used;
+}
+
+ArenaScope::ArenaScope(Arena &arena) noexcept : previous(current)
+{
+    current = &arena;
+}
+
+ArenaScope::~ArenaScope()
+{
+    current = this->previous;
+}
+
+void installArenaHooks() noexcept
+{
+    xmlMemSetup(arenaFree, arenaMalloc, arenaRealloc, arenaStrdup);
+}
+} // namespace cpplibxml2::detail
+
+#endif
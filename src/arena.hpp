@@ -0,0 +1,68 @@
+#pragma once
+
+#ifdef CPPLIBXML2_ENABLE_ARENA
+
+#include <cstddef>
+#include <vector>
+
+namespace cpplibxml2::detail
+{
+/**
+ * Bump allocator backing Doc::parseInArena.
+ *
+ * While an ArenaScope is active on a thread, every libxml2 allocation made on that thread is carved out of the arena;
+ * xmlFree on arena memory is a no-op and the whole arena is released at once when it is destroyed. Chunks are
+ * recycled through a process-wide pool and never handed back to the system allocator, which is what lets the free
+ * hook recognize arena memory by address alone.
+ */
+class Arena
+{
+    struct Chunk
+    {
+        std::byte *data;
+        std::size_t size;
+    };
+
+    std::vector<Chunk> chunks;
+    std::byte *cursor = nullptr;
+    std::byte *limit = nullptr;
+    std::size_t used = 0;
+
+  public:
+    Arena() = default;
+
+    Arena(const Arena &) = delete;
+
+    Arena &operator=(const Arena &) = delete;
+
+    ~Arena();
+
+    [[nodiscard]] void *allocate(std::size_t size) noexcept;
+
+    [[nodiscard]] std::size_t bytesUsed() const noexcept;
+};
+
+/**
+ * Routes the calling thread's libxml2 allocations into `arena` for the lifetime of the scope.
+ */
+class ArenaScope
+{
+    Arena *previous;
+
+  public:
+    explicit ArenaScope(Arena &arena) noexcept;
+
+    ArenaScope(const ArenaScope &) = delete;
+
+    ArenaScope &operator=(const ArenaScope &) = delete;
+
+    ~ArenaScope();
+};
+
+/**
+ * Installs the arena-aware allocation functions with xmlMemSetup. Called once by initLibrary().
+ */
+void installArenaHooks() noexcept;
+} // namespace cpplibxml2::detail
+
+#endif
@@ -0,0 +1,132 @@
+#include "batchParser.hpp"
+
+#include "helper.hpp"
+#include "parser.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace cpplibxml2
+{
+namespace
+{
+// Doc has no default state, so result slots start out as errors until a worker fills them in.
+std::vector<BatchParser::Result> pendingResults(const std::size_t count)
+{
+    std::vector<BatchParser::Result> results;
+    results.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        results.emplace_back(std::unexpect, "Document not parsed successfully.");
+    return results;
+}
+} // namespace
+
+struct BatchParser::Impl
+{
+    ParserOptions options;
+    std::size_t threads;
+
+    /**
+     * Runs job(index, parser) for every index in [0, count) on up to `threads` threads.
+     */
+    template <typename Job> void run(const std::size_t count, Job &&job)
+    {
+        initLibrary();
+
+        std::atomic<std::size_t> next{0};
+        std::mutex failureMutex;
+        std::exception_ptr failure;
+
+        const auto worker = [&](Parser &parser) {
+            try
+            {
+                for (auto index = next.fetch_add(1, std::memory_order_relaxed); index < count;
+                     index = next.fetch_add(1, std::memory_order_relaxed))
+                    job(index, parser);
+            }
+            catch (...)
+            {
+                const std::lock_guard lock{failureMutex};
+                if (!failure)
+                    failure = std::current_exception();
+                // Let the other workers run dry.
+                next.store(count, std::memory_order_relaxed);
+            }
+        };
+
+        const auto workers = std::min(this->threads, count);
+        // Fresh parsers for every batch: the Docs of earlier batches share the dictionaries of their parsers, and may
+        // be destroyed on other threads while this batch runs.
+        std::vector<Parser> parsers(workers);
+        if (workers > 0)
+        {
+            std::vector<std::jthread> pool;
+            pool.reserve(workers - 1);
+            for (std::size_t i = 1; i < workers; ++i)
+                pool.emplace_back(worker, std::ref(parsers[i]));
+            worker(parsers.front());
+        }
+
+        if (failure)
+            std::rethrow_exception(failure);
+    }
+};
+
+BatchParser::BatchParser(const std::size_t threads, const ParserOptions options) : impl(std::make_unique<Impl>())
+{
+    this->impl->options = options;
+    this->impl->threads = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+BatchParser::BatchParser(BatchParser &&) noexcept = default;
+
+BatchParser::~BatchParser() = default;
+
+BatchParser &BatchParser::operator=(BatchParser &&) noexcept = default;
+
+std::size_t BatchParser::threads() const noexcept
+{
+    return this->impl->threads;
+}
+
+std::vector<BatchParser::Result> BatchParser::parseFiles(const std::span<const std::filesystem::path> paths)
+{
+    auto results = pendingResults(paths.size());
+    this->impl->run(paths.size(), [&](const std::size_t index, Parser &parser) {
+        results[index] = parser.parseFile(paths[index], this->impl->options);
+    });
+    return results;
+}
+
+std::vector<BatchParser::Result> BatchParser::parse(const std::span<const std::string_view> inputs)
+{
+    auto results = pendingResults(inputs.size());
+    this->impl->run(inputs.size(), [&](const std::size_t index, Parser &parser) {
+        results[index] = parser.parse(inputs[index], this->impl->options);
+    });
+    return results;
+}
+
+void BatchParser::parseFiles(const std::span<const std::filesystem::path> paths, const Callback &callback)
+{
+    std::mutex callbackMutex;
+    this->impl->run(paths.size(), [&](const std::size_t index, Parser &parser) {
+        auto result = parser.parseFile(paths[index], this->impl->options);
+        const std::lock_guard lock{callbackMutex};
+        callback(index, std::move(result));
+    });
+}
+
+void BatchParser::parse(const std::span<const std::string_view> inputs, const Callback &callback)
+{
+    std::mutex callbackMutex;
+    this->impl->run(inputs.size(), [&](const std::size_t index, Parser &parser) {
+        auto result = parser.parse(inputs[index], this->impl->options);
+        const std::lock_guard lock{callbackMutex};
+        callback(index, std::move(result));
+    });
+}
+} // namespace cpplibxml2
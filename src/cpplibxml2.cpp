@@ -1,19 +1,76 @@
 #include "cpplibxml2.hpp"
 
+#include "access.hpp"
+#include "arena.hpp"
 #include "helper.hpp"
+#include "inputIo.hpp"
+#include "instrumentation.hpp"
+#include "mappedFile.hpp"
 
+#include <algorithm>
+#include <charconv>
 #include <functional>
+#include <istream>
+#include <libxml/catalog.h>
 #include <libxml/parser.h>
 
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
 
 namespace cpplibxml2
 {
+void initLibrary() noexcept
+{
+    static std::once_flag initialized;
+    std::call_once(initialized, [] {
+#ifdef CPPLIBXML2_ENABLE_ARENA
+        // Has to come first so that no block allocated by libxml2 itself is handed to the wrong free function.
+        detail::installArenaHooks();
+#endif
+        // Initialize the library and check potential ABI mismatches
+        LIBXML_TEST_VERSION
+        xmlInitParser();
+#if defined(CPPLIBXML2_ENABLE_ARENA) && defined(LIBXML_CATALOG_ENABLED)
+        // The catalogs are otherwise created lazily by the first parse that needs them, possibly inside an arena.
+        xmlInitializeCatalog();
+#endif
+    });
+}
+
+namespace
+{
+/**
+ * The name interned in the document's dictionary, or a copy owned by the caller if the document has none.
+ * Either way the result can be handed to the libxml2 *EatName functions, which only free names outside the
+ * dictionary.
+ */
+xmlChar *internName(const xmlDocPtr doc, const std::string_view name) noexcept
+{
+    if (name.size() > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+        return nullptr;
+    const auto data = reinterpret_cast<const xmlChar *>(name.data());
+    const auto len = static_cast<int>(name.size());
+    if (doc && doc->dict)
+        return const_cast<xmlChar *>(xmlDictLookup(doc->dict, data, len));
+    return xmlStrndup(data, len);
+}
+
+xmlNodePtr newElement(const xmlDocPtr doc, const std::string_view name) noexcept
+{
+    const auto interned = internName(doc, name);
+    return interned ? xmlNewDocNodeEatName(doc, nullptr, interned, nullptr) : nullptr;
+}
 
-struct Doc::Impl
+xmlNodePtr newText(const xmlDocPtr doc, const std::string_view text) noexcept
 {
-    xmlDocPtr_t doc;
-};
+    if (text.size() > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+        return nullptr;
+    return xmlNewDocTextLen(doc, reinterpret_cast<const xmlChar *>(text.data()), static_cast<int>(text.size()));
+}
+} // namespace
 
 Doc::Doc() : impl(std::make_unique<Impl>())
 {
@@ -25,53 +82,191 @@ Doc::~Doc() = default;
 
 Doc &Doc::operator=(Doc &&) noexcept = default;
 
+namespace
+{
+/**
+ * xmlReadMemory for inputs of any size. Inputs too large for its int length are fed through a read callback in
+ * chunks instead.
+ */
+xmlDocPtr readMemory(const std::string_view input, const char *url, const ParserOptions options) noexcept
+{
+    if (input.size() <= detail::maxMemoryInput)
+        return xmlReadMemory(input.data(), static_cast<int>(input.size()), url, nullptr, static_cast<int>(options));
+
+    auto context = detail::MemoryInput{input};
+    return xmlReadIO(detail::readFromMemory, nullptr, &context, url, nullptr, static_cast<int>(options));
+}
+} // namespace
+
 std::expected<Doc, RuntimeError> Doc::parseFile(const std::filesystem::path &path, ParserOptions options) noexcept
 {
-    // Initialize the library and check potential ABI mismatches
-    LIBXML_TEST_VERSION
+    initLibrary();
+    CPPLIBXML2_STATS_TIME(Parse);
+    CPPLIBXML2_STATS_ADD(ParseCalls, 1);
 
     if (!std::filesystem::exists(path))
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
         return std::unexpected{RuntimeError{"Document don't exist."}};
+    }
+    CPPLIBXML2_STATS_ADD(BytesParsed, detail::fileSize(path));
 
     auto doc = xmlDocPtr_t(xmlReadFile(path.string().c_str(), nullptr, static_cast<int>(options)));
 
     if (!doc)
     {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
         return std::unexpected{RuntimeError{"Document not parsed successfully."}};
     }
 
-    auto result = Doc{};
-    result.impl->doc = std::move(doc);
+    return detail::Access::makeDoc(std::move(doc));
+}
 
-    return result;
+std::expected<Doc, RuntimeError> Doc::parseMappedFile(const std::filesystem::path &path,
+                                                     const ParserOptions options) noexcept
+{
+    initLibrary();
+    CPPLIBXML2_STATS_TIME(Parse);
+    CPPLIBXML2_STATS_ADD(ParseCalls, 1);
+
+    const auto file = MappedFile::open(path);
+    if (!file)
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
+        return std::unexpected{file.error()};
+    }
+
+    const auto input = file.value().view();
+    CPPLIBXML2_STATS_ADD(BytesParsed, input.size());
+    if (input.empty())
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
+        return std::unexpected{RuntimeError{"Document not parsed successfully."}};
+    }
+
+    // libxml2 parses static memory in place, up to 2 GiB; the URL keeps relative DTD and entity lookups working.
+    auto doc = xmlDocPtr_t(readMemory(input, path.string().c_str(), options));
+
+    if (!doc)
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
+        return std::unexpected{RuntimeError{"Document not parsed successfully."}};
+    }
+
+    return detail::Access::makeDoc(std::move(doc));
 }
 
 std::expected<Doc, RuntimeError> Doc::parse(const std::string_view input, ParserOptions options) noexcept
 {
-    // Initialize the library and check potential ABI mismatches
-    LIBXML_TEST_VERSION
+    initLibrary();
+    CPPLIBXML2_STATS_TIME(Parse);
+    CPPLIBXML2_STATS_ADD(ParseCalls, 1);
 
+    CPPLIBXML2_STATS_ADD(BytesParsed, input.size());
     if (input.empty())
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
         return std::unexpected{RuntimeError{"Document is empty."}};
+    }
+
+    auto doc = xmlDocPtr_t(readMemory(input, nullptr, options));
+
+    if (!doc)
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
+        return std::unexpected{RuntimeError{"Document not parsed successfully."}};
+    }
+
+    return detail::Access::makeDoc(std::move(doc));
+}
+
+std::expected<Doc, RuntimeError> Doc::parse(std::istream &input, const ParserOptions options) noexcept
+{
+    initLibrary();
+    CPPLIBXML2_STATS_TIME(Parse);
+    CPPLIBXML2_STATS_ADD(ParseCalls, 1);
 
-    auto doc = xmlDocPtr_t(
-        xmlReadMemory(input.data(), static_cast<int>(input.size()), nullptr, nullptr, static_cast<int>(options)));
+    auto context = detail::StreamInput{&input, 0, false};
+    auto doc =
+        xmlDocPtr_t(xmlReadIO(detail::readFromStream, nullptr, &context, nullptr, nullptr, static_cast<int>(options)));
+    CPPLIBXML2_STATS_ADD(BytesParsed, context.bytesRead);
 
+    if (context.failed)
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
+        return std::unexpected{RuntimeError{"Failed to read input."}};
+    }
+    if (context.bytesRead == 0)
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
+        return std::unexpected{RuntimeError{"Document is empty."}};
+    }
     if (!doc)
     {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
         return std::unexpected{RuntimeError{"Document not parsed successfully."}};
     }
 
-    auto result = Doc{};
-    result.impl->doc = std::move(doc);
+    return detail::Access::makeDoc(std::move(doc));
+}
 
+#ifdef CPPLIBXML2_ENABLE_ARENA
+std::expected<Doc, RuntimeError> Doc::parseInArena(const std::string_view input, const ParserOptions options) noexcept
+{
+    initLibrary();
+    CPPLIBXML2_STATS_TIME(Parse);
+    CPPLIBXML2_STATS_ADD(ParseCalls, 1);
+
+    CPPLIBXML2_STATS_ADD(BytesParsed, input.size());
+    if (input.empty())
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
+        return std::unexpected{RuntimeError{"Document is empty."}};
+    }
+
+    auto arena = std::make_unique<detail::Arena>();
+    xmlDocPtr doc;
+    {
+        const detail::ArenaScope scope{*arena};
+        doc = readMemory(input, nullptr, options);
+        // The thread's last error was copied into the arena; don't leave it pointing there.
+        xmlResetLastError();
+    }
+
+    if (!doc)
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
+        return std::unexpected{RuntimeError{"Document not parsed successfully."}};
+    }
+
+    auto result = detail::Access::makeDoc(xmlDocPtr_t{doc});
+    result.impl->arena = std::move(arena);
     return result;
 }
+#endif
 
-struct Node::Impl
+std::expected<Doc, RuntimeError> Doc::create(const std::string_view rootName) noexcept
 {
-    xmlNodePtr node;
-};
+    initLibrary();
+
+    if (rootName.empty())
+        return std::unexpected{RuntimeError{"Node name is empty."}};
+
+    auto doc = xmlDocPtr_t(xmlNewDoc(reinterpret_cast<const xmlChar *>("1.0")));
+    if (!doc)
+        return std::unexpected{RuntimeError{"Failed to create document."}};
+    // Freed together with the document by xmlFreeDoc.
+    doc->dict = xmlDictCreate();
+    if (!doc->dict)
+        return std::unexpected{RuntimeError{"Failed to create document."}};
+
+    const auto root = newElement(doc.get(), rootName);
+    if (!root)
+        return std::unexpected{RuntimeError{"Failed to create node."}};
+    xmlDocSetRootElement(doc.get(), root);
+
+    return detail::Access::makeDoc(std::move(doc));
+}
 
 std::expected<Node, RuntimeError> Doc::root() const noexcept
 {
@@ -79,15 +274,96 @@ std::expected<Node, RuntimeError> Doc::root() const noexcept
     if (!root)
         return std::unexpected{RuntimeError{"Document has no root node."}};
 
-    auto rootNode = Node{};
-    rootNode.impl->node = root;
-    return rootNode;
+    CPPLIBXML2_STATS_ADD(NodeHandles, 1);
+    return Node{root};
+}
+
+NameKey::NameKey(const NameKey &other) : dict(other.dict), interned(other.interned), name(other.name)
+{
+    if (this->dict)
+        xmlDictReference(this->dict);
+}
+
+NameKey::NameKey(NameKey &&other) noexcept
+    : dict(std::exchange(other.dict, nullptr)), interned(std::exchange(other.interned, nullptr)),
+      name(std::move(other.name))
+{
+}
+
+NameKey::~NameKey()
+{
+    // Keeps the interned pointer valid: a dictionary freed with its document could be replaced at the same address.
+    if (this->dict)
+        xmlDictFree(this->dict);
+}
+
+NameKey &NameKey::operator=(const NameKey &other)
+{
+    if (this != &other)
+        *this = NameKey{other};
+    return *this;
 }
+
+NameKey &NameKey::operator=(NameKey &&other) noexcept
+{
+    if (this != &other)
+    {
+        if (this->dict)
+            xmlDictFree(this->dict);
+        this->dict = std::exchange(other.dict, nullptr);
+        this->interned = std::exchange(other.interned, nullptr);
+        this->name = std::move(other.name);
+    }
+    return *this;
+}
+
+NameKey Doc::intern(const std::string_view name)
+{
+    NameKey key;
+    key.name = name;
+#ifdef CPPLIBXML2_ENABLE_ARENA
+    // The arena is reused once the document is gone, so the key cannot hold on to the dictionary.
+    if (this->impl->arena)
+        return key;
+#endif
+    const auto doc = this->impl->doc.get();
+    if (doc && doc->dict)
+    {
+        key.dict = doc->dict;
+        xmlDictReference(key.dict);
+        key.interned = internName(doc, name);
+    }
+    return key;
+}
+
+NameKey Doc::nameKey(const std::string_view name) const
+{
+    NameKey key;
+    key.name = name;
+#ifdef CPPLIBXML2_ENABLE_ARENA
+    // The arena is reused once the document is gone, so the key cannot hold on to the dictionary.
+    if (this->impl->arena)
+        return key;
+#endif
+    const auto doc = this->impl->doc.get();
+    if (doc && doc->dict)
+    {
+        key.dict = doc->dict;
+        xmlDictReference(key.dict);
+        // Stays null if the name was never interned: no element of this document can have it then.
+        key.interned = xmlDictExists(doc->dict, reinterpret_cast<const xmlChar *>(name.data()),
+                                     static_cast<int>(name.size()));
+    }
+    return key;
+}
+
 std::expected<std::string, RuntimeError> Doc::dump(const bool addWhiteSpaces, const Format format) const noexcept
 {
     if (!this->impl->doc)
         return std::unexpected{RuntimeError{"Document is null."}};
 
+    CPPLIBXML2_STATS_TIME(Serialize);
+    CPPLIBXML2_STATS_ADD(SerializeCalls, 1);
     xmlChar *buffer = nullptr;
     int size = -1;
     xmlDocDumpFormatMemoryEnc(this->impl->doc.get(), &buffer, &size, to_string(format).c_str(), addWhiteSpaces ? 1 : 0);
@@ -95,6 +371,8 @@ std::expected<std::string, RuntimeError> Doc::dump(const bool addWhiteSpaces, co
         return std::unexpected{RuntimeError{"Failed to dump document."}};
 
     std::string result(reinterpret_cast<const char *>(buffer), static_cast<std::string::size_type>(size));
+    xmlFree(buffer);
+    CPPLIBXML2_STATS_ADD(SerializedBytes, result.size());
     return result;
 }
 
@@ -104,6 +382,8 @@ std::expected<void, RuntimeError> Doc::saveToFile(const std::filesystem::path &p
     if (!this->impl->doc)
         return std::unexpected{RuntimeError{"Document is null."}};
 
+    CPPLIBXML2_STATS_TIME(Serialize);
+    CPPLIBXML2_STATS_ADD(SerializeCalls, 1);
     const std::string encoding = to_string(format);
     const int formatFlag = addWhiteSpaces ? 1 : 0;
 
@@ -112,40 +392,57 @@ std::expected<void, RuntimeError> Doc::saveToFile(const std::filesystem::path &p
     if (rc == -1)
         return std::unexpected{RuntimeError{"Failed to write XML document to file."}};
 
+    CPPLIBXML2_STATS_ADD(SerializedBytes, rc);
     return {};
 }
 
-Node::Node() : impl(std::make_unique<Impl>())
-{
-}
-
-Node::Node(Node &&) noexcept = default;
-
-Node::~Node() = default;
-
-Node &Node::operator=(Node &&) noexcept = default;
-
 std::expected<std::string_view, RuntimeError> Node::name() const noexcept
 {
-    if (!this->impl->node)
+    if (!this->handle)
         return std::unexpected{RuntimeError{"Node is null."}};
-    return std::string_view{reinterpret_cast<const char *>(this->impl->node->name)};
+    // Document nodes have no name.
+    return toStringView(this->handle->name);
 }
 
 std::expected<Node, RuntimeError> Node::findChild(const std::string_view name) const noexcept
 {
-    if (!this->impl->node)
+    if (!this->handle)
         return std::unexpected{RuntimeError{"Node not found."}};
-    for (auto node = this->impl->node->children; node; node = node->next)
+    for (auto node = this->handle->children; node; node = node->next)
     {
+        CPPLIBXML2_STATS_ADD(NodesVisited, 1);
         if (node->type != XML_ELEMENT_NODE)
             continue;
 
-        if (std::string{reinterpret_cast<const char *>(node->name)} == name)
+        if (toStringView(node->name) == name)
+        {
+            CPPLIBXML2_STATS_ADD(NodeHandles, 1);
+            return Node{node};
+        }
+    }
+    return std::unexpected{RuntimeError{"Node not found."}};
+}
+
+bool Node::hasName(const NameKey &key) const noexcept
+{
+    if (!this->handle)
+        return false;
+    if (key.dict && this->handle->doc && this->handle->doc->dict == key.dict)
+        return this->handle->name == key.interned;
+    return toStringView(this->handle->name) == key.name;
+}
+
+std::expected<Node, RuntimeError> Node::findChild(const NameKey &key) const noexcept
+{
+    if (!this->handle)
+        return std::unexpected{RuntimeError{"Node not found."}};
+    for (auto node = this->handle->children; node; node = node->next)
+    {
+        CPPLIBXML2_STATS_ADD(NodesVisited, 1);
+        if (node->type == XML_ELEMENT_NODE && Node{node}.hasName(key))
         {
-            auto rootNode = Node{};
-            rootNode.impl->node = node;
-            return rootNode;
+            CPPLIBXML2_STATS_ADD(NodeHandles, 1);
+            return Node{node};
         }
     }
     return std::unexpected{RuntimeError{"Node not found."}};
@@ -154,11 +451,12 @@ std::expected<Node, RuntimeError> Node::findChild(const std::string_view name) c
 std::expected<Node, RuntimeError> Node::findChild(const std::string_view name,
                                                   const std::string_view nsUri) const noexcept
 {
-    if (!this->impl->node)
+    if (!this->handle)
         return std::unexpected{RuntimeError{"Node is null."}};
 
-    for (auto node = this->impl->node->children; node; node = node->next)
+    for (auto node = this->handle->children; node; node = node->next)
     {
+        CPPLIBXML2_STATS_ADD(NodesVisited, 1);
         if (node->type != XML_ELEMENT_NODE)
             continue;
 
@@ -167,9 +465,8 @@ std::expected<Node, RuntimeError> Node::findChild(const std::string_view name,
 
         if (name == localName && nsUri == href)
         {
-            auto rootNode = Node{};
-            rootNode.impl->node = node;
-            return rootNode;
+            CPPLIBXML2_STATS_ADD(NodeHandles, 1);
+            return Node{node};
         }
     }
 
@@ -178,36 +475,275 @@ std::expected<Node, RuntimeError> Node::findChild(const std::string_view name,
 
 std::expected<std::vector<Node>, RuntimeError> Node::getChildren() const noexcept
 {
-    if (!this->impl->node)
+    if (!this->handle)
         return std::unexpected{RuntimeError{"Node is null."}};
 
     std::vector<Node> result;
-    for (auto node = this->impl->node->children; node; node = node->next)
+    for (auto node = this->handle->children; node; node = node->next)
     {
+        CPPLIBXML2_STATS_ADD(NodesVisited, 1);
         if (node->type != XML_ELEMENT_NODE)
             continue;
 
-        auto rootNode = Node{};
-        rootNode.impl->node = node;
-        result.emplace_back(std::move(rootNode));
+        result.emplace_back(Node{node});
     }
 
+    CPPLIBXML2_STATS_ADD(NodeHandles, result.size());
     return result;
 }
 
+NodeType Node::type() const noexcept
+{
+    return static_cast<NodeType>(this->handle->type);
+}
+
+namespace detail
+{
+namespace
+{
+/**
+ * Counts `node`, if any, as visited by a walk.
+ */
+xmlNodePtr visit(const xmlNodePtr node) noexcept
+{
+    if (node)
+        CPPLIBXML2_STATS_ADD(NodesVisited, 1);
+    return node;
+}
+
+xmlNodePtr nextElement(xmlNodePtr node) noexcept
+{
+    while (visit(node) && node->type != XML_ELEMENT_NODE)
+        node = node->next;
+    return node;
+}
+
+xmlNodePtr preorderNext(xmlNodePtr node, const _xmlNode *origin) noexcept
+{
+    if (node->type == XML_ELEMENT_NODE && node->children)
+        return node->children;
+    for (; node && node != origin; node = node->parent)
+    {
+        if (node->next)
+            return node->next;
+    }
+    return nullptr;
+}
+
+xmlNodePtr nextDescendant(xmlNodePtr node, const _xmlNode *origin) noexcept
+{
+    do
+    {
+        node = visit(preorderNext(node, origin));
+    } while (node && node->type != XML_ELEMENT_NODE);
+    return node;
+}
+
+xmlNodePtr elementParent(const _xmlNode *node) noexcept
+{
+    return node->parent && node->parent->type == XML_ELEMENT_NODE ? node->parent : nullptr;
+}
+} // namespace
+
+_xmlNode *first(const NodeAxis axis, _xmlNode *origin) noexcept
+{
+    if (!origin)
+        return nullptr;
+
+    switch (axis)
+    {
+    case NodeAxis::Children:
+        return visit(origin->children);
+    case NodeAxis::Elements:
+        return nextElement(origin->children);
+    case NodeAxis::Siblings:
+        return nextElement(origin->next);
+    case NodeAxis::Descendants:
+        return nextDescendant(origin, origin);
+    case NodeAxis::Ancestors:
+        return visit(elementParent(origin));
+    }
+    return nullptr;
+}
+
+_xmlNode *next(const NodeAxis axis, _xmlNode *current, const _xmlNode *origin) noexcept
+{
+    switch (axis)
+    {
+    case NodeAxis::Children:
+        return visit(current->next);
+    case NodeAxis::Elements:
+    case NodeAxis::Siblings:
+        return nextElement(current->next);
+    case NodeAxis::Descendants:
+        return nextDescendant(current, origin);
+    case NodeAxis::Ancestors:
+        return visit(elementParent(current));
+    }
+    return nullptr;
+}
+} // namespace detail
+
 using xmlChar_t = std::unique_ptr<xmlChar, decltype([](xmlChar *in) { xmlFree(in); })>;
 
-std::expected<std::string, RuntimeError> Node::value() const noexcept
+namespace
+{
+/**
+ * Text that libxml2 already keeps in a single buffer: character data nodes themselves, an empty element, or an
+ * element whose only child is one text/CDATA node.
+ */
+std::optional<std::string_view> contiguousContent(const xmlNode *node) noexcept
 {
-    if (!this->impl->node)
+    switch (node->type)
+    {
+    case XML_TEXT_NODE:
+    case XML_CDATA_SECTION_NODE:
+    case XML_COMMENT_NODE:
+    case XML_PI_NODE:
+        return toStringView(node->content);
+    case XML_ELEMENT_NODE: {
+        const auto child = node->children;
+        if (!child)
+            return std::string_view{};
+        if (child == node->last && (child->type == XML_TEXT_NODE || child->type == XML_CDATA_SECTION_NODE))
+            return toStringView(child->content);
+        return std::nullopt;
+    }
+    default:
+        return std::nullopt;
+    }
+}
+} // namespace
+
+std::expected<std::string_view, RuntimeError> Node::valueView() const noexcept
+{
+    if (!this->handle)
         return std::unexpected{RuntimeError{"Node is null."}};
-    const auto content = xmlChar_t{xmlNodeGetContent(this->impl->node)};
+    if (const auto content = contiguousContent(this->handle))
+        return content.value();
+    return std::unexpected{RuntimeError{"Node content is not contiguous."}};
+}
+
+std::expected<std::string_view, RuntimeError> Node::valueView(std::string &buffer) const
+{
+    if (!this->handle)
+        return std::unexpected{RuntimeError{"Node is null."}};
+    if (const auto content = contiguousContent(this->handle))
+        return content.value();
+
+    buffer.clear();
+    if (this->handle->type != XML_ELEMENT_NODE)
+    {
+        const auto content = xmlChar_t{xmlNodeGetContent(this->handle)};
+        if (!content)
+            return std::unexpected{RuntimeError{"Failed to get node content."}};
+        buffer.append(reinterpret_cast<const char *>(content.get()));
+        CPPLIBXML2_STATS_ADD(ValueCopies, 1);
+        CPPLIBXML2_STATS_ADD(ValueBytesCopied, buffer.size());
+        return std::string_view{buffer};
+    }
+
+    // Same concatenation as xmlNodeGetContent, written straight into the caller's buffer.
+    for (auto node = detail::preorderNext(this->handle, this->handle); node;
+         node = detail::preorderNext(node, this->handle))
+    {
+        CPPLIBXML2_STATS_ADD(NodesVisited, 1);
+        if (node->type == XML_TEXT_NODE || node->type == XML_CDATA_SECTION_NODE)
+            buffer.append(toStringView(node->content));
+        else if (node->type == XML_ENTITY_REF_NODE)
+        {
+            const auto content = xmlChar_t{xmlNodeGetContent(node)};
+            buffer.append(toStringView(content.get()));
+        }
+    }
+    CPPLIBXML2_STATS_ADD(ValueCopies, 1);
+    CPPLIBXML2_STATS_ADD(ValueBytesCopied, buffer.size());
+    return std::string_view{buffer};
+}
+
+std::expected<std::string, RuntimeError> Node::value() const noexcept
+{
+    std::string buffer;
+    const auto content = this->valueView(buffer);
     if (!content)
-        return std::unexpected{RuntimeError{"Failed to get node content."}};
+        return std::unexpected{content.error()};
+    if (content.value().data() == buffer.data())
+        return buffer;
+    CPPLIBXML2_STATS_ADD(ValueCopies, 1);
+    CPPLIBXML2_STATS_ADD(ValueBytesCopied, content.value().size());
+    return std::string{content.value()};
+}
 
-    std::string result(reinterpret_cast<const char *>(content.get()));
-    return result;
+namespace
+{
+constexpr std::string_view xmlWhitespace = " \t\r\n";
+
+constexpr std::string_view trimXmlWhitespace(std::string_view text) noexcept
+{
+    const auto begin = text.find_first_not_of(xmlWhitespace);
+    if (begin == std::string_view::npos)
+        return {};
+    const auto end = text.find_last_not_of(xmlWhitespace);
+    return text.substr(begin, end - begin + 1);
 }
+} // namespace
+
+template <Convertible T>
+std::expected<T, ConversionError> parseValue(const std::string_view text, const int base) noexcept
+{
+    const auto trimmed = trimXmlWhitespace(text);
+    if (trimmed.empty())
+        return std::unexpected{ConversionError::Empty};
+
+    if constexpr (std::same_as<T, bool>)
+    {
+        if (trimmed == "true" || trimmed == "1")
+            return true;
+        if (trimmed == "false" || trimmed == "0")
+            return false;
+        return std::unexpected{ConversionError::InvalidFormat};
+    }
+    else
+    {
+        if constexpr (std::integral<T>)
+        {
+            if (base < 2 || base > 36)
+                return std::unexpected{ConversionError::InvalidBase};
+        }
+
+        auto first = trimmed.data();
+        const auto last = first + trimmed.size();
+        // from_chars only understands a leading '-', the XML schema numeric types also allow '+'.
+        if (*first == '+' && last - first > 1 && first[1] != '-')
+            ++first;
+
+        T result{};
+        std::from_chars_result parsed;
+        if constexpr (std::floating_point<T>)
+            parsed = std::from_chars(first, last, result);
+        else
+            parsed = std::from_chars(first, last, result, base);
+
+        if (parsed.ec == std::errc::result_out_of_range)
+            return std::unexpected{ConversionError::OutOfRange};
+        if (parsed.ec != std::errc{} || parsed.ptr != last)
+            return std::unexpected{ConversionError::InvalidFormat};
+        return result;
+    }
+}
+
+template std::expected<bool, ConversionError> parseValue<bool>(std::string_view, int) noexcept;
+template std::expected<short, ConversionError> parseValue<short>(std::string_view, int) noexcept;
+template std::expected<unsigned short, ConversionError> parseValue<unsigned short>(std::string_view, int) noexcept;
+template std::expected<int, ConversionError> parseValue<int>(std::string_view, int) noexcept;
+template std::expected<unsigned int, ConversionError> parseValue<unsigned int>(std::string_view, int) noexcept;
+template std::expected<long, ConversionError> parseValue<long>(std::string_view, int) noexcept;
+template std::expected<unsigned long, ConversionError> parseValue<unsigned long>(std::string_view, int) noexcept;
+template std::expected<long long, ConversionError> parseValue<long long>(std::string_view, int) noexcept;
+template std::expected<unsigned long long, ConversionError> parseValue<unsigned long long>(std::string_view,
+                                                                                          int) noexcept;
+template std::expected<float, ConversionError> parseValue<float>(std::string_view, int) noexcept;
+template std::expected<double, ConversionError> parseValue<double>(std::string_view, int) noexcept;
 
 std::expected<float, InvalidArgument> Node::valueAsFloat() const
 {
@@ -251,10 +787,14 @@ std::expected<long long, InvalidArgument> Node::valueAsLongLong(int base) const
 std::expected<std::pair<std::string_view, std::string_view>, RuntimeError> Node::findProperty(
     const std::string_view name) const noexcept
 {
-    if (!this->impl->node)
+    if (!this->handle)
         return std::unexpected{RuntimeError{"Node not found."}};
-    for (auto node = this->impl->node->properties; node; node = node->next)
+    // Only elements have attributes; other node types have different fields in that place.
+    if (this->handle->type != XML_ELEMENT_NODE)
+        return std::unexpected{RuntimeError{"Property not found."}};
+    for (auto node = this->handle->properties; node; node = node->next)
     {
+        CPPLIBXML2_STATS_ADD(NodesVisited, 1);
         if (auto nodeName = std::string_view{reinterpret_cast<const char *>(node->name)}; nodeName == name)
         {
             return std::pair<std::string_view, std::string_view>{
@@ -264,59 +804,209 @@ std::expected<std::pair<std::string_view, std::string_view>, RuntimeError> Node:
     return std::unexpected{RuntimeError{"Property not found."}};
 }
 
+namespace
+{
+std::string_view attributeNsUri(const xmlAttr *attr) noexcept
+{
+    return attr->ns ? toStringView(attr->ns->href) : std::string_view{};
+}
+} // namespace
+
+std::expected<std::pair<std::string_view, std::string_view>, RuntimeError> Node::findProperty(
+    const std::string_view name, const std::string_view nsUri) const noexcept
+{
+    if (!this->handle)
+        return std::unexpected{RuntimeError{"Node not found."}};
+    if (this->handle->type != XML_ELEMENT_NODE)
+        return std::unexpected{RuntimeError{"Property not found."}};
+    for (auto attr = this->handle->properties; attr; attr = attr->next)
+    {
+        CPPLIBXML2_STATS_ADD(NodesVisited, 1);
+        if (const auto attrName = toStringView(attr->name); attrName == name && attributeNsUri(attr) == nsUri)
+            return std::pair{attrName, attributeValue(attr)};
+    }
+    return std::unexpected{RuntimeError{"Property not found."}};
+}
+
+std::optional<std::string_view> Node::attribute(const std::string_view name) const noexcept
+{
+    if (!this->handle || this->handle->type != XML_ELEMENT_NODE)
+        return std::nullopt;
+    for (auto attr = this->handle->properties; attr; attr = attr->next)
+    {
+        CPPLIBXML2_STATS_ADD(NodesVisited, 1);
+        if (toStringView(attr->name) == name)
+            return attributeValue(attr);
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string_view> Node::attribute(const std::string_view name,
+                                                const std::string_view nsUri) const noexcept
+{
+    if (!this->handle || this->handle->type != XML_ELEMENT_NODE)
+        return std::nullopt;
+    for (auto attr = this->handle->properties; attr; attr = attr->next)
+    {
+        CPPLIBXML2_STATS_ADD(NodesVisited, 1);
+        if (toStringView(attr->name) == name && attributeNsUri(attr) == nsUri)
+            return attributeValue(attr);
+    }
+    return std::nullopt;
+}
+
 std::vector<std::pair<std::string_view, std::string_view>> Node::getProperties() const noexcept
 {
-    if (!this->impl->node)
+    if (!this->handle || this->handle->type != XML_ELEMENT_NODE)
         return {};
 
     std::vector<std::pair<std::string_view, std::string_view>> result;
-    for (auto node = this->impl->node->properties; node; node = node->next)
+    for (auto node = this->handle->properties; node; node = node->next)
     {
         result.emplace_back(std::string_view{reinterpret_cast<const char *>(node->name)},
                             node->children ? reinterpret_cast<const char *>(node->children->content) : "");
     }
 
+    CPPLIBXML2_STATS_ADD(NodesVisited, result.size());
     return result;
 }
 
 std::pair<std::string_view, std::string_view> Node::getNamespace() const noexcept
 {
-    if (!this->impl->node)
+    // Only elements and attributes have a namespace field.
+    if (!this->handle || (this->handle->type != XML_ELEMENT_NODE && this->handle->type != XML_ATTRIBUTE_NODE))
         return {};
-    if (this->impl->node->ns)
-    {
-        return {std::string_view{reinterpret_cast<const char *>(this->impl->node->ns->prefix)},
-                std::string_view{reinterpret_cast<const char *>(this->impl->node->ns->href)}};
-    }
+    if (this->handle->ns)
+        return {toStringView(this->handle->ns->prefix), toStringView(this->handle->ns->href)};
 
     return {};
 }
 
 std::expected<Node, RuntimeError> Node::addChild(const std::string_view name) const noexcept
 {
-    if (!this->impl->node)
+    if (!this->handle)
         return std::unexpected{RuntimeError{"Node not found."}};
 
-    const auto child = xmlNewNode(nullptr, reinterpret_cast<const unsigned char *>(name.data()));
+    // Created in the document so the name is interned in its dictionary, which NameKey matching relies on.
+    const auto child = newElement(this->handle->doc, name);
 
     if (!child)
         return std::unexpected{RuntimeError{"Failed to create node."}};
 
-    const auto newNode = xmlAddChild(this->impl->node, child);
+    const auto newNode = xmlAddChild(this->handle, child);
     if (!newNode)
+    {
+        xmlFreeNode(child);
         return std::unexpected{RuntimeError{"Failed to add node."}};
+    }
 
-    auto rootNode = Node{};
-    rootNode.impl->node = newNode;
-    return rootNode;
+    CPPLIBXML2_STATS_ADD(NodeHandles, 1);
+    return Node{newNode};
+}
+
+std::expected<Node, RuntimeError> Node::addChild(const NameKey &key) const noexcept
+{
+    if (!this->handle)
+        return std::unexpected{RuntimeError{"Node not found."}};
+
+    const auto doc = this->handle->doc;
+    if (!key.interned || !doc || key.dict != doc->dict)
+        return this->addChild(key.view());
+
+    const auto child = xmlNewDocNodeEatName(doc, nullptr, const_cast<xmlChar *>(key.interned), nullptr);
+    if (!child)
+        return std::unexpected{RuntimeError{"Failed to create node."}};
+
+    const auto newNode = xmlAddChild(this->handle, child);
+    if (!newNode)
+    {
+        xmlFreeNode(child);
+        return std::unexpected{RuntimeError{"Failed to add node."}};
+    }
+
+    CPPLIBXML2_STATS_ADD(NodeHandles, 1);
+    return Node{newNode};
+}
+
+std::expected<Node, RuntimeError> Node::addChild(const std::string_view name,
+                                                 const std::string_view text) const noexcept
+{
+    return this->addChild(name).and_then([text](const Node child) -> std::expected<Node, RuntimeError> {
+        if (text.empty())
+            return child;
+        return child.appendText(text).transform([child] { return child; });
+    });
+}
+
+std::expected<void, RuntimeError> Node::setAttribute(const std::string_view name,
+                                                     const std::string_view value) const noexcept
+{
+    if (!this->handle)
+        return std::unexpected{RuntimeError{"Node not found."}};
+    if (this->handle->type != XML_ELEMENT_NODE)
+        return std::unexpected{RuntimeError{"Node is not an element."}};
+
+    const auto doc = this->handle->doc;
+    const auto interned = internName(doc, name);
+    if (!interned)
+        return std::unexpected{RuntimeError{"Failed to add attribute."}};
+    // Built by hand from a length-delimited text node: xmlSetProp needs NUL-terminated strings and would parse the
+    // value for entity references.
+    const auto attr = reinterpret_cast<xmlNodePtr>(xmlNewDocProp(doc, interned, nullptr));
+    if (!doc || !doc->dict)
+        xmlFree(interned);
+    if (!attr)
+        return std::unexpected{RuntimeError{"Failed to add attribute."}};
+
+    if (!value.empty())
+    {
+        const auto text = newText(doc, value);
+        if (!text)
+        {
+            xmlFreeProp(reinterpret_cast<xmlAttrPtr>(attr));
+            return std::unexpected{RuntimeError{"Failed to add attribute."}};
+        }
+        attr->children = text;
+        attr->last = text;
+        text->parent = attr;
+    }
+
+    // Replaces an existing attribute of the same name.
+    if (!xmlAddChild(this->handle, attr))
+    {
+        xmlFreeProp(reinterpret_cast<xmlAttrPtr>(attr));
+        return std::unexpected{RuntimeError{"Failed to add attribute."}};
+    }
+    return {};
+}
+
+std::expected<void, RuntimeError> Node::appendText(const std::string_view text) const noexcept
+{
+    if (!this->handle)
+        return std::unexpected{RuntimeError{"Node not found."}};
+
+    const auto child = newText(this->handle->doc, text);
+    if (!child)
+        return std::unexpected{RuntimeError{"Failed to add value."}};
+
+    // Merges into a preceding text node, in which case `child` has been freed already.
+    if (!xmlAddChild(this->handle, child))
+    {
+        xmlFreeNode(child);
+        return std::unexpected{RuntimeError{"Failed to add value."}};
+    }
+    return {};
 }
 
 void Node::addValue(const std::string_view value) const
 {
-    if (!this->impl->node)
+    if (!this->handle)
         throw RuntimeError{"Node not found."};
+    if (value.size() > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+        throw RuntimeError{"Failed to add value."};
 
-    const auto res = xmlNodeSetContent(this->impl->node, reinterpret_cast<const unsigned char *>(value.data()));
+    const auto res = xmlNodeSetContentLen(this->handle, reinterpret_cast<const unsigned char *>(value.data()),
+                                          static_cast<int>(value.size()));
     if (res == 1)
         throw RuntimeError{"Failed to add value."};
     if (res == -1)
@@ -325,19 +1015,59 @@ void Node::addValue(const std::string_view value) const
 
 void Node::addNamespace(const std::string_view prefix, const std::string_view uri) const
 {
-    if (!this->impl->node)
+    if (!this->handle)
         throw RuntimeError{"Node not found."};
-    const auto ns = xmlNewNs(this->impl->node, reinterpret_cast<const unsigned char *>(uri.data()),
+    const auto ns = xmlNewNs(this->handle, reinterpret_cast<const unsigned char *>(uri.data()),
                              reinterpret_cast<const unsigned char *>(prefix.data()));
     if (!ns)
         throw RuntimeError{"Failed to add namespace."};
-    xmlSetNs(this->impl->node, ns);
+    xmlSetNs(this->handle, ns);
 }
 
 void Node::removeNamespace() const
 {
-    if (!this->impl->node)
+    if (!this->handle)
         throw RuntimeError{"Node not found."};
-    xmlSetNs(this->impl->node, nullptr);
+    xmlSetNs(this->handle, nullptr);
+}
+
+AttributeIndex::AttributeIndex(const Node node)
+{
+    const auto element = detail::Access::raw(node);
+    if (!element || element->type != XML_ELEMENT_NODE)
+        return;
+    for (auto attr = element->properties; attr; attr = attr->next)
+        this->entries.push_back({toStringView(attr->name), attributeNsUri(attr), attributeValue(attr)});
+    CPPLIBXML2_STATS_ADD(NodesVisited, this->entries.size());
+    std::ranges::sort(this->entries, {}, [](const Entry &entry) { return std::pair{entry.name, entry.nsUri}; });
+}
+
+std::optional<std::string_view> AttributeIndex::find(const std::string_view name) const noexcept
+{
+    const auto it = std::ranges::lower_bound(this->entries, name, {}, &Entry::name);
+    if (it == this->entries.end() || it->name != name)
+        return std::nullopt;
+    return it->value;
+}
+
+std::optional<std::string_view> AttributeIndex::find(const std::string_view name,
+                                                     const std::string_view nsUri) const noexcept
+{
+    const auto key = std::pair{name, nsUri};
+    const auto it = std::ranges::lower_bound(this->entries, key, {},
+                                             [](const Entry &entry) { return std::pair{entry.name, entry.nsUri}; });
+    if (it == this->entries.end() || it->name != name || it->nsUri != nsUri)
+        return std::nullopt;
+    return it->value;
+}
+
+std::size_t AttributeIndex::size() const noexcept
+{
+    return this->entries.size();
+}
+
+bool AttributeIndex::empty() const noexcept
+{
+    return this->entries.empty();
 }
 } // namespace cpplibxml2
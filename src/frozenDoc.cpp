@@ -0,0 +1,127 @@
+#include "frozenDoc.hpp"
+
+#include "access.hpp"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace cpplibxml2
+{
+struct FrozenDoc::Impl
+{
+    Doc doc;
+
+    std::mutex mutex;
+    detail::ExpressionCache expressions;
+    std::vector<XPathContext> idleContexts;
+
+    explicit Impl(Doc &&frozen) : doc(std::move(frozen))
+    {
+    }
+
+    std::expected<XPathContext, RuntimeError> acquireContext()
+    {
+        {
+            const std::lock_guard lock{this->mutex};
+            if (!this->idleContexts.empty())
+            {
+                auto context = std::move(this->idleContexts.back());
+                this->idleContexts.pop_back();
+                return context;
+            }
+        }
+
+        auto context = XPathContext::create(this->doc);
+        if (context)
+        {
+            if (const auto root = this->doc.root())
+                (void)context.value().registerNamespaces(root.value());
+        }
+        return context;
+    }
+
+    void releaseContext(XPathContext &&context)
+    {
+        const std::lock_guard lock{this->mutex};
+        this->idleContexts.push_back(std::move(context));
+    }
+
+    /**
+     * The returned expression stays valid when another thread evicts it from the cache.
+     */
+    std::expected<std::shared_ptr<const XPathExpression>, RuntimeError> expression(const std::string_view text)
+    {
+        {
+            const std::lock_guard lock{this->mutex};
+            if (auto cached = this->expressions.find(text))
+                return cached;
+        }
+
+        // Compile outside the lock; if another thread won the race its expression is kept.
+        auto compiled = XPathExpression::compile(text);
+        if (!compiled)
+            return std::unexpected{compiled.error()};
+        const std::lock_guard lock{this->mutex};
+        return this->expressions.insert(text, std::move(compiled.value()));
+    }
+
+    std::expected<XPathResult, RuntimeError> evaluate(const XPathExpression &expression, const Node context)
+    {
+        auto xpath = this->acquireContext();
+        if (!xpath)
+            return std::unexpected{xpath.error()};
+        auto result = xpath.value().evaluate(expression, context);
+        this->releaseContext(std::move(xpath.value()));
+        return result;
+    }
+
+    [[nodiscard]] Node documentNode() const noexcept
+    {
+        return detail::Access::makeNode(reinterpret_cast<xmlNodePtr>(detail::Access::raw(this->doc)));
+    }
+};
+
+FrozenDoc::FrozenDoc(Doc &&doc) : impl(std::make_unique<Impl>(std::move(doc)))
+{
+}
+
+FrozenDoc::FrozenDoc(FrozenDoc &&) noexcept = default;
+
+FrozenDoc::~FrozenDoc() = default;
+
+FrozenDoc &FrozenDoc::operator=(FrozenDoc &&) noexcept = default;
+
+std::expected<Node, RuntimeError> FrozenDoc::root() const noexcept
+{
+    return this->impl->doc.root();
+}
+
+NameKey FrozenDoc::nameKey(const std::string_view name) const
+{
+    return this->impl->doc.nameKey(name);
+}
+
+std::expected<XPathResult, RuntimeError> FrozenDoc::query(const std::string_view expression) const
+{
+    return this->query(expression, this->impl->documentNode());
+}
+
+std::expected<XPathResult, RuntimeError> FrozenDoc::query(const std::string_view expression, const Node context) const
+{
+    return this->impl->expression(expression).and_then(
+        [this, context](const std::shared_ptr<const XPathExpression> &compiled) {
+            return this->impl->evaluate(*compiled, context);
+        });
+}
+
+std::expected<XPathResult, RuntimeError> FrozenDoc::query(const XPathExpression &expression) const
+{
+    return this->impl->evaluate(expression, this->impl->documentNode());
+}
+
+std::expected<XPathResult, RuntimeError> FrozenDoc::query(const XPathExpression &expression, const Node context) const
+{
+    return this->impl->evaluate(expression, context);
+}
+} // namespace cpplibxml2
@@ -3,9 +3,12 @@
 #include "errorTypes.hpp"
 
 #include <libxml/parser.h>
+#include <libxml/xmlreader.h>
 
 #include <expected>
 #include <functional>
+#include <memory>
+#include <string_view>
 
 namespace cpplibxml2
 {
@@ -26,6 +29,29 @@ std::expected<OutputType, InvalidArgument> to_value(std::function<OutputType(Inp
     }
 }
 
+/**
+ * Initializes libxml2 and checks for ABI mismatches. Only the first call does any work.
+ */
+void initLibrary() noexcept;
+
+[[nodiscard]] inline std::string_view toStringView(const xmlChar *in) noexcept
+{
+    return in ? std::string_view{reinterpret_cast<const char *>(in)} : std::string_view{};
+}
+
+[[nodiscard]] inline std::string_view toStringView(const xmlChar *in, const int len) noexcept
+{
+    return {reinterpret_cast<const char *>(in), static_cast<std::size_t>(len)};
+}
+
+/**
+ * The value of a parsed attribute, which the tree builder stores as a single text child.
+ */
+[[nodiscard]] inline std::string_view attributeValue(const xmlAttr *attr) noexcept
+{
+    return attr->children ? toStringView(attr->children->content) : std::string_view{};
+}
+
 struct xmlDocDeleter
 {
     void operator()(xmlDoc *doc) const
@@ -38,4 +64,66 @@ struct xmlDocDeleter
 };
 
 using xmlDocPtr_t = std::unique_ptr<xmlDoc, xmlDocDeleter>;
+
+struct xmlParserCtxtDeleter
+{
+    void operator()(xmlParserCtxt *ctxt) const
+    {
+        if (ctxt)
+        {
+            xmlFreeParserCtxt(ctxt);
+        }
+    }
+};
+
+using xmlParserCtxtPtr_t = std::unique_ptr<xmlParserCtxt, xmlParserCtxtDeleter>;
+
+/*
+ * Newer libxml2 releases deprecate direct access to the parser context fields, older ones have no accessors for
+ * them. Keep the field access in one place.
+ */
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#elif defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#endif
+[[nodiscard]] inline xmlDocPtr_t takeDocument(xmlParserCtxt *ctxt) noexcept
+{
+    auto doc = xmlDocPtr_t{ctxt->myDoc};
+    ctxt->myDoc = nullptr;
+    return doc;
+}
+
+[[nodiscard]] inline bool isWellFormed(const xmlParserCtxt *ctxt) noexcept
+{
+    return ctxt->wellFormed != 0;
+}
+
+/**
+ * The node the SAX2 tree builder appends to.
+ */
+[[nodiscard]] inline xmlNodePtr currentNode(const xmlParserCtxt *ctxt) noexcept
+{
+    return ctxt->node;
+}
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+struct xmlTextReaderDeleter
+{
+    void operator()(xmlTextReader *reader) const
+    {
+        if (reader)
+        {
+            xmlFreeTextReader(reader);
+        }
+    }
+};
+
+using xmlTextReaderPtr_t = std::unique_ptr<xmlTextReader, xmlTextReaderDeleter>;
 } // namespace cpplibxml2
@@ -0,0 +1,58 @@
+#include "inputIo.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+
+namespace cpplibxml2::detail
+{
+int readFromMemory(void *context, char *buffer, const int len) noexcept
+{
+    auto &input = static_cast<MemoryInput *>(context)->rest;
+    const auto chunk = std::min(input.size(), static_cast<std::size_t>(len));
+    std::memcpy(buffer, input.data(), chunk);
+    input.remove_prefix(chunk);
+    return static_cast<int>(chunk);
+}
+
+int readFromParts(void *context, char *buffer, const int len) noexcept
+{
+    auto &input = *static_cast<PartsInput *>(context);
+    auto remaining = static_cast<std::size_t>(len);
+    while (remaining > 0 && input.current < input.parts.size())
+    {
+        auto &part = input.parts[input.current];
+        const auto chunk = std::min(part.size(), remaining);
+        std::memcpy(buffer, part.data(), chunk);
+        part.remove_prefix(chunk);
+        buffer += chunk;
+        remaining -= chunk;
+        if (part.empty())
+            ++input.current;
+    }
+    return len - static_cast<int>(remaining);
+}
+
+int readFromStream(void *context, char *buffer, const int len) noexcept
+{
+    auto &input = *static_cast<StreamInput *>(context);
+    auto failed = false;
+    try
+    {
+        input.stream->read(buffer, len);
+    }
+    catch (...)
+    {
+        // A stream with exceptions(failbit) throws on the short read at the end of the input.
+        failed = !input.stream->eof();
+    }
+    if (failed || input.stream->bad())
+    {
+        input.failed = true;
+        return -1;
+    }
+    const auto chunk = input.stream->gcount();
+    input.bytesRead += static_cast<std::uint64_t>(chunk);
+    return static_cast<int>(chunk);
+}
+} // namespace cpplibxml2::detail
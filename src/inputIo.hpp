@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <string_view>
+
+namespace cpplibxml2::detail
+{
+/**
+ * The largest input libxml2's memory parsers take, their length parameter is an int. Larger inputs are fed through
+ * readFromMemory() instead.
+ */
+inline constexpr auto maxMemoryInput = static_cast<std::size_t>(std::numeric_limits<int>::max());
+
+/**
+ * Context of an xmlParserInputBuffer reading from memory, see readFromMemory().
+ */
+struct MemoryInput
+{
+    std::string_view rest;
+};
+
+/**
+ * xmlInputReadCallback copying the next chunk of MemoryInput::rest. libxml2 asks for a few kilobytes at a time and
+ * discards what it consumed, so its buffering stays bounded however large the input is.
+ */
+int readFromMemory(void *context, char *buffer, int len) noexcept;
+
+/**
+ * Context of an xmlParserInputBuffer reading several buffers as one input, see readFromParts(). Unused parts are
+ * left empty.
+ */
+struct PartsInput
+{
+    std::array<std::string_view, 4> parts;
+    std::size_t current;
+};
+
+/**
+ * xmlInputReadCallback copying the next chunk of PartsInput::parts, moving on to the next part when one is used up.
+ */
+int readFromParts(void *context, char *buffer, int len) noexcept;
+
+/**
+ * Context of an xmlParserInputBuffer reading from a stream, see readFromStream().
+ */
+struct StreamInput
+{
+    std::istream *stream;
+    std::uint64_t bytesRead;
+    bool failed;
+};
+
+/**
+ * xmlInputReadCallback reading the next chunk from StreamInput::stream. Exceptions must not cross the libxml2 frames,
+ * a throwing or bad stream only sets StreamInput::failed. The short read at the end of the input is not a failure, even
+ * when the stream throws on failbit.
+ */
+int readFromStream(void *context, char *buffer, int len) noexcept;
+} // namespace cpplibxml2::detail
@@ -0,0 +1,111 @@
+#pragma once
+
+/*
+ * Instrumentation points for stats.hpp. With CPPLIBXML2_ENABLE_STATS off the macros expand to nothing and their
+ * arguments are not evaluated.
+ */
+
+#ifdef CPPLIBXML2_ENABLE_STATS
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <type_traits>
+
+namespace cpplibxml2::detail
+{
+enum class Counter : std::size_t
+{
+    ParseCalls,
+    ParseFailures,
+    BytesParsed,
+    NodesVisited,
+    NodeHandles,
+    ValueCopies,
+    ValueBytesCopied,
+    SerializeCalls,
+    SerializedBytes,
+    Count
+};
+
+enum class Timer : std::size_t
+{
+    Parse,
+    Serialize,
+    Count
+};
+
+void addToCounter(Counter counter, std::uint64_t amount) noexcept;
+
+void recordDuration(Timer timer, std::uint64_t nanoseconds) noexcept;
+
+/**
+ * Records the time until the end of the enclosing scope, unless discarded.
+ */
+class ScopedTimer
+{
+    Timer timer;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool discarded = false;
+
+  public:
+    explicit ScopedTimer(const Timer kind) noexcept : timer(kind)
+    {
+    }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+    void discard() noexcept
+    {
+        this->discarded = true;
+    }
+
+    ~ScopedTimer()
+    {
+        if (this->discarded)
+            return;
+        const auto elapsed = std::chrono::steady_clock::now() - this->start;
+        recordDuration(this->timer, static_cast<std::uint64_t>(
+                                        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+};
+
+/**
+ * Converts the sizes and counts passed to CPPLIBXML2_STATS_ADD, which come in all integer types.
+ */
+template <typename T> [[nodiscard]] constexpr std::uint64_t toCount(const T amount) noexcept
+{
+    if constexpr (std::is_same_v<T, std::uint64_t>)
+        return amount;
+    else
+        return static_cast<std::uint64_t>(amount);
+}
+
+[[nodiscard]] inline std::uint64_t fileSize(const std::filesystem::path &path) noexcept
+{
+    std::error_code error;
+    const auto size = std::filesystem::file_size(path, error);
+    return error ? 0 : toCount(size);
+}
+} // namespace cpplibxml2::detail
+
+#define CPPLIBXML2_STATS_ADD(counter, amount)                                                                          \
+    ::cpplibxml2::detail::addToCounter(::cpplibxml2::detail::Counter::counter, ::cpplibxml2::detail::toCount(amount))
+#define CPPLIBXML2_STATS_TIME(timer)                                                                                   \
+    ::cpplibxml2::detail::ScopedTimer cpplibxml2StatsTimer                                                             \
+    {                                                                                                                  \
+        ::cpplibxml2::detail::Timer::timer                                                                             \
+    }
+// Drops the time of the enclosing CPPLIBXML2_STATS_TIME, for calls that hand over to another counted one.
+#define CPPLIBXML2_STATS_DISCARD_TIME() cpplibxml2StatsTimer.discard()
+
+#else
+
+#define CPPLIBXML2_STATS_ADD(counter, amount) static_cast<void>(0)
+#define CPPLIBXML2_STATS_TIME(timer) static_cast<void>(0)
+#define CPPLIBXML2_STATS_DISCARD_TIME() static_cast<void>(0)
+
+#endif
@@ -0,0 +1,146 @@
+#include "mappedFile.hpp"
+
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cpplibxml2
+{
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data(std::exchange(other.data, nullptr)), size(std::exchange(other.size, 0))
+#ifdef _WIN32
+      ,
+      mapping(std::exchange(other.mapping, nullptr))
+#endif
+{
+}
+
+MappedFile::~MappedFile()
+{
+    release();
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+#ifdef _WIN32
+        mapping = std::exchange(other.mapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+void MappedFile::release() noexcept
+{
+    if (data)
+        UnmapViewOfFile(data);
+    if (mapping)
+        CloseHandle(mapping);
+    data = nullptr;
+    mapping = nullptr;
+    size = 0;
+}
+
+std::expected<MappedFile, RuntimeError> MappedFile::open(const std::filesystem::path &path) noexcept
+{
+    const auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        const auto error = GetLastError();
+        if (error == ERROR_FILE_NOT_FOUND || error == ERROR_PATH_NOT_FOUND)
+            return std::unexpected{RuntimeError{"Document don't exist."}};
+        return std::unexpected{RuntimeError{"Failed to open document."}};
+    }
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        return std::unexpected{RuntimeError{"Failed to open document."}};
+    }
+
+    auto result = MappedFile{};
+    result.size = static_cast<std::size_t>(fileSize.QuadPart);
+    if (result.size == 0)
+    {
+        CloseHandle(file);
+        return result;
+    }
+
+    result.mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!result.mapping)
+        return std::unexpected{RuntimeError{"Failed to map document."}};
+
+    result.data = static_cast<const char *>(MapViewOfFile(result.mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!result.data)
+        return std::unexpected{RuntimeError{"Failed to map document."}};
+
+    return result;
+}
+#else
+void MappedFile::release() noexcept
+{
+    if (data)
+        munmap(const_cast<char *>(data), size);
+    data = nullptr;
+    size = 0;
+}
+
+std::expected<MappedFile, RuntimeError> MappedFile::open(const std::filesystem::path &path) noexcept
+{
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        if (errno == ENOENT || errno == ENOTDIR)
+            return std::unexpected{RuntimeError{"Document don't exist."}};
+        return std::unexpected{RuntimeError{"Failed to open document."}};
+    }
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        return std::unexpected{RuntimeError{"Failed to open document."}};
+    }
+
+    auto result = MappedFile{};
+    result.size = static_cast<std::size_t>(info.st_size);
+    if (result.size == 0)
+    {
+        close(fd);
+        return result;
+    }
+
+    void *mapped = mmap(nullptr, result.size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file.
+    close(fd);
+    if (mapped == MAP_FAILED)
+        return std::unexpected{RuntimeError{"Failed to map document."}};
+
+    madvise(mapped, result.size, MADV_SEQUENTIAL);
+    result.data = static_cast<const char *>(mapped);
+    return result;
+}
+#endif
+} // namespace cpplibxml2
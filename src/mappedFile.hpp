@@ -0,0 +1,45 @@
+#pragma once
+
+#include "errorTypes.hpp"
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <string_view>
+
+namespace cpplibxml2
+{
+/**
+ * Read-only memory mapping of a whole file, hinted for sequential access.
+ */
+class MappedFile
+{
+    const char *data = nullptr;
+    std::size_t size = 0;
+#ifdef _WIN32
+    void *mapping = nullptr;
+#endif
+
+    MappedFile() = default;
+
+    void release() noexcept;
+
+  public:
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&) noexcept;
+
+    ~MappedFile();
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile &operator=(MappedFile &&) noexcept;
+
+    [[nodiscard]] static std::expected<MappedFile, RuntimeError> open(const std::filesystem::path &path) noexcept;
+
+    [[nodiscard]] std::string_view view() const noexcept
+    {
+        return {data, size};
+    }
+};
+} // namespace cpplibxml2
@@ -0,0 +1,149 @@
+#include "outputSink.hpp"
+
+#include "access.hpp"
+#include "helper.hpp"
+#include "instrumentation.hpp"
+#include "sinkIo.hpp"
+
+#include <libxml/xmlsave.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <ostream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace cpplibxml2
+{
+namespace detail
+{
+int writeToSink(void *context, const char *buffer, const int len)
+{
+    const auto sinkContext = static_cast<SinkContext *>(context);
+    CPPLIBXML2_STATS_ADD(SerializedBytes, len);
+    try
+    {
+        return sinkContext->sink->write({buffer, static_cast<std::size_t>(len)}) ? len : -1;
+    }
+    catch (...)
+    {
+        sinkContext->exception = std::current_exception();
+        return -1;
+    }
+}
+} // namespace detail
+
+namespace
+{
+std::expected<void, RuntimeError> save(xmlNodePtr node, OutputSink &sink, const bool addWhiteSpaces,
+                                       const Format format)
+{
+    CPPLIBXML2_STATS_TIME(Serialize);
+    CPPLIBXML2_STATS_ADD(SerializeCalls, 1);
+    auto context = detail::SinkContext{&sink, nullptr};
+    const auto saveContext = xmlSaveToIO(detail::writeToSink, nullptr, &context, to_string(format).c_str(),
+                                         addWhiteSpaces ? XML_SAVE_FORMAT : 0);
+    if (!saveContext)
+        return std::unexpected{RuntimeError{"Failed to create output buffer."}};
+
+    const long saved = node->type == XML_DOCUMENT_NODE ? xmlSaveDoc(saveContext, reinterpret_cast<xmlDocPtr>(node))
+                                                       : xmlSaveTree(saveContext, node);
+    // Closing flushes libxml2's own buffer and reports any write error that happened on the way.
+    const int closed = xmlSaveClose(saveContext);
+
+    if (context.exception)
+        std::rethrow_exception(context.exception);
+    if (saved < 0 || closed < 0)
+        return std::unexpected{RuntimeError{"Failed to write to output sink."}};
+    if (!sink.flush())
+        return std::unexpected{RuntimeError{"Failed to write to output sink."}};
+    return {};
+}
+} // namespace
+
+OutputSink::OutputSink(Callback onChunk) : callback(std::move(onChunk))
+{
+}
+
+OutputSink::OutputSink(std::ostream &stream)
+    : callback([&stream](const std::string_view chunk) {
+          stream.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+          return !stream.fail();
+      })
+{
+}
+
+OutputSink::OutputSink(const std::span<char> storage, Callback onChunk)
+    : callback(std::move(onChunk)), buffer(storage)
+{
+}
+
+OutputSink OutputSink::fileDescriptor(const int fd)
+{
+    return OutputSink{[fd](std::string_view chunk) {
+        while (!chunk.empty())
+        {
+#ifdef _WIN32
+            const auto written = _write(fd, chunk.data(), static_cast<unsigned>(chunk.size()));
+#else
+            const auto written = ::write(fd, chunk.data(), chunk.size());
+#endif
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+            chunk.remove_prefix(static_cast<std::size_t>(written));
+        }
+        return true;
+    }};
+}
+
+bool OutputSink::write(std::string_view chunk)
+{
+    if (this->buffer.empty())
+        return this->callback(chunk);
+
+    while (!chunk.empty())
+    {
+        const auto count = std::min(chunk.size(), this->buffer.size() - this->used);
+        std::copy_n(chunk.data(), count, this->buffer.data() + this->used);
+        this->used += count;
+        chunk.remove_prefix(count);
+
+        if (this->used == this->buffer.size() && !this->flush())
+            return false;
+    }
+    return true;
+}
+
+bool OutputSink::flush()
+{
+    if (this->used == 0)
+        return true;
+    const auto pending = std::string_view{this->buffer.data(), this->used};
+    this->used = 0;
+    return this->callback(pending);
+}
+
+std::expected<void, RuntimeError> Doc::serialize(OutputSink sink, const bool addWhiteSpaces,
+                                                 const Format format) const
+{
+    if (!this->impl->doc)
+        return std::unexpected{RuntimeError{"Document is null."}};
+    return save(reinterpret_cast<xmlNodePtr>(this->impl->doc.get()), sink, addWhiteSpaces, format);
+}
+
+std::expected<void, RuntimeError> Node::serialize(OutputSink sink, const bool addWhiteSpaces,
+                                                  const Format format) const
+{
+    if (!this->handle)
+        return std::unexpected{RuntimeError{"Node is null."}};
+    return save(this->handle, sink, addWhiteSpaces, format);
+}
+} // namespace cpplibxml2
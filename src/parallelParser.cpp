@@ -0,0 +1,433 @@
+#include "parallelParser.hpp"
+
+#include "access.hpp"
+#include "helper.hpp"
+#include "inputIo.hpp"
+#include "instrumentation.hpp"
+#include "mappedFile.hpp"
+
+#include <libxml/parser.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cpplibxml2
+{
+namespace
+{
+constexpr std::string_view whitespace = " \t\r\n";
+
+// How far back a cut candidate is checked for an unterminated comment, CDATA section or processing instruction.
+constexpr std::size_t lookBehind = 64 * 1024;
+
+// Chunks per thread, so that a chunk of large records does not hold up the others.
+constexpr std::size_t chunksPerThread = 4;
+
+/**
+ * Where the root element and its body are in the input.
+ */
+struct Layout
+{
+    // The input up to the end of the XML declaration, repeated in front of every chunk. Empty if there is none.
+    std::string_view declaration;
+    std::string_view rootStartTag;
+    std::string_view rootName;
+    std::size_t bodyBegin;
+    std::size_t bodyEnd;
+};
+
+/**
+ * Finds the root element of documents the split can handle: no DOCTYPE, a root that is not empty and a root end tag
+ * that is the last end tag of the input.
+ */
+std::optional<Layout> findLayout(const std::string_view input) noexcept
+{
+    Layout layout{};
+    std::size_t pos = input.starts_with("\xEF\xBB\xBF") ? 3 : 0;
+    if (input.substr(pos).starts_with("<?xml") && input.size() > pos + 5 && whitespace.contains(input[pos + 5]))
+    {
+        const auto end = input.find("?>", pos);
+        if (end == std::string_view::npos)
+            return std::nullopt;
+        pos = end + 2;
+    }
+    layout.declaration = input.substr(0, pos);
+
+    // The prolog: comments and processing instructions only.
+    while (true)
+    {
+        pos = input.find_first_not_of(whitespace, pos);
+        if (pos == std::string_view::npos)
+            return std::nullopt;
+        const auto rest = input.substr(pos);
+        std::string_view closing;
+        if (rest.starts_with("<!--"))
+            closing = "-->";
+        else if (rest.starts_with("<?"))
+            closing = "?>";
+        else if (rest.starts_with('<') && rest.size() > 1 && rest[1] != '!')
+            break;
+        else
+            return std::nullopt;
+        const auto end = input.find(closing, pos + 2);
+        if (end == std::string_view::npos)
+            return std::nullopt;
+        pos = end + closing.size();
+    }
+
+    const auto nameEnd = input.find_first_of(" \t\r\n/>", pos + 1);
+    if (nameEnd == std::string_view::npos || nameEnd == pos + 1)
+        return std::nullopt;
+    layout.rootName = input.substr(pos + 1, nameEnd - pos - 1);
+
+    // '>' may appear in attribute values.
+    char quote = 0;
+    auto tagEnd = nameEnd;
+    for (; tagEnd < input.size(); ++tagEnd)
+    {
+        const auto c = input[tagEnd];
+        if (quote != 0)
+            quote = c == quote ? 0 : quote;
+        else if (c == '"' || c == '\'')
+            quote = c;
+        else if (c == '>')
+            break;
+    }
+    if (tagEnd == input.size() || input[tagEnd - 1] == '/')
+        return std::nullopt;
+    layout.bodyBegin = tagEnd + 1;
+    layout.rootStartTag = input.substr(pos, layout.bodyBegin - pos);
+
+    layout.bodyEnd = input.rfind("</");
+    if (layout.bodyEnd == std::string_view::npos || layout.bodyEnd < layout.bodyBegin)
+        return std::nullopt;
+    auto endTag = input.substr(layout.bodyEnd + 2);
+    if (!endTag.starts_with(layout.rootName))
+        return std::nullopt;
+    endTag.remove_prefix(layout.rootName.size());
+    endTag.remove_prefix(std::min(endTag.find_first_not_of(whitespace), endTag.size()));
+    if (!endTag.starts_with('>'))
+        return std::nullopt;
+    return layout;
+}
+
+/**
+ * Whether `pos` lies in a comment, CDATA section or processing instruction opened at most lookBehind bytes and not
+ * before `floor`.
+ */
+bool insideMarkup(const std::string_view input, const std::size_t pos, const std::size_t floor) noexcept
+{
+    const auto from = std::max(floor, pos > lookBehind ? pos - lookBehind : 0);
+    const auto window = input.substr(from, pos - from);
+    const auto open = [window](const std::string_view opening, const std::string_view closing) {
+        const auto opened = window.rfind(opening);
+        if (opened == std::string_view::npos)
+            return false;
+        const auto closed = window.rfind(closing);
+        return closed == std::string_view::npos || closed < opened;
+    };
+    return open("<!--", "-->") || open("<![CDATA[", "]]>") || open("<?", "?>");
+}
+
+/**
+ * Start offsets of the chunks: the body start, then record start tags at or after evenly spaced positions.
+ */
+std::vector<std::size_t> findCuts(const std::string_view input, const Layout &layout, const std::string_view recordName,
+                                  const std::size_t chunks)
+{
+    const auto pattern = std::string{"<"}.append(recordName);
+    const auto bodySize = layout.bodyEnd - layout.bodyBegin;
+    std::vector<std::size_t> cuts{layout.bodyBegin};
+    for (std::size_t k = 1; k < chunks; ++k)
+    {
+        auto pos = std::max(layout.bodyBegin + bodySize / chunks * k, cuts.back() + 1);
+        while (true)
+        {
+            pos = input.find(pattern, pos);
+            if (pos == std::string_view::npos || pos + pattern.size() >= layout.bodyEnd)
+                return cuts;
+            if (whitespace.contains(input[pos + pattern.size()]) || input[pos + pattern.size()] == '>' ||
+                input[pos + pattern.size()] == '/')
+            {
+                if (!insideMarkup(input, pos, cuts.back()))
+                    break;
+            }
+            ++pos;
+        }
+        cuts.push_back(pos);
+    }
+    return cuts;
+}
+
+bool hasQualifiedName(const xmlNode *node, const std::string_view name) noexcept
+{
+    const auto local = toStringView(node->name);
+    if (!node->ns || !node->ns->prefix)
+        return local == name;
+    const auto prefix = toStringView(node->ns->prefix);
+    return name.size() == prefix.size() + 1 + local.size() && name.starts_with(prefix) && name[prefix.size()] == ':' &&
+           name.ends_with(local);
+}
+
+struct Chunk
+{
+    std::size_t begin;
+    std::size_t end;
+    xmlDocPtr_t doc;
+};
+
+/**
+ * Runs job(index) for every index in [0, count) on up to `threads` threads, the calling one included.
+ */
+void runParallel(const std::size_t count, const std::size_t threads, const std::function<void(std::size_t)> &job)
+{
+    std::atomic<std::size_t> next{0};
+    const auto worker = [&] {
+        for (auto index = next.fetch_add(1, std::memory_order_relaxed); index < count;
+             index = next.fetch_add(1, std::memory_order_relaxed))
+            job(index);
+    };
+
+    std::vector<std::jthread> pool;
+    const auto workers = std::min(threads, count);
+    pool.reserve(workers > 0 ? workers - 1 : 0);
+    for (std::size_t i = 1; i < workers; ++i)
+        pool.emplace_back(worker);
+    worker();
+}
+
+/**
+ * Points the nodes below `chunkRoot` to the target document, and their namespaces declared on the chunk's root (or
+ * the chunk document's xml namespace) to the equivalent ones of the target.
+ */
+void adopt(xmlDocPtr chunkDoc, xmlNodePtr chunkRoot, xmlDocPtr target, xmlNodePtr targetRoot, xmlNsPtr targetXmlNs)
+{
+    const auto remap = [&](xmlNsPtr ns) {
+        if (!ns)
+            return ns;
+        if (ns == chunkDoc->oldNs)
+            return targetXmlNs;
+        for (auto from = chunkRoot->nsDef, to = targetRoot->nsDef; from && to; from = from->next, to = to->next)
+        {
+            if (from == ns)
+                return to;
+        }
+        return ns;
+    };
+
+    auto node = chunkRoot->children;
+    while (node)
+    {
+        node->doc = target;
+        if (node->type == XML_ELEMENT_NODE)
+        {
+            node->ns = remap(node->ns);
+            for (auto attr = node->properties; attr; attr = attr->next)
+            {
+                attr->doc = target;
+                attr->ns = remap(attr->ns);
+                for (auto text = attr->children; text; text = text->next)
+                    text->doc = target;
+            }
+            if (node->children)
+            {
+                node = node->children;
+                continue;
+            }
+        }
+        while (node != chunkRoot && !node->next)
+            node = node->parent;
+        node = node == chunkRoot ? nullptr : node->next;
+    }
+
+    for (auto child = chunkRoot->children; child; child = child->next)
+        child->parent = targetRoot;
+}
+
+thread_local std::size_t chunksSpliced = 0;
+} // namespace
+
+struct ParallelParser::Impl
+{
+    std::size_t threads;
+    ParserOptions options;
+    std::size_t minChunkSize = 1 << 20;
+
+    /**
+     * @return The document, or std::nullopt if the input has to be parsed serially
+     */
+    std::optional<Doc> parse(const std::string_view input, const std::string_view recordName) const
+    {
+        // On one thread the split only adds the work of cutting and stitching.
+        if (this->threads < 2)
+            return std::nullopt;
+        const auto layout = findLayout(input);
+        if (!layout || recordName.empty())
+            return std::nullopt;
+        const auto chunkCount =
+            std::min(this->threads * chunksPerThread, (layout->bodyEnd - layout->bodyBegin) / this->minChunkSize);
+        if (chunkCount < 2)
+            return std::nullopt;
+
+        const auto cuts = findCuts(input, *layout, recordName, chunkCount);
+        if (cuts.size() < 2)
+            return std::nullopt;
+
+        // A failed split hands over to Doc::parse, which counts the call.
+        CPPLIBXML2_STATS_TIME(Parse);
+
+        std::vector<Chunk> chunks;
+        chunks.reserve(cuts.size());
+        for (std::size_t i = 0; i < cuts.size(); ++i)
+            chunks.push_back({cuts[i], i + 1 < cuts.size() ? cuts[i + 1] : input.size(), nullptr});
+
+        // Errors are expected from a bad cut; real ones are reported by the serial parse. Recovering would turn a bad
+        // cut into a truncated chunk that is never parsed again.
+        const auto chunkOptions = static_cast<int>((this->options & ~ParserOptions::Recover) | ParserOptions::NoDict |
+                                                   ParserOptions::NoError | ParserOptions::NoWarning);
+        const auto closingTag = std::string{"</"}.append(layout->rootName).append(">");
+        std::atomic<bool> hasIds{false};
+        const auto parseChunk = [&](Chunk &chunk, const bool first) {
+            const auto last = chunk.end == input.size();
+            auto parts = detail::PartsInput{{}, 0};
+            if (first)
+                parts.parts = {input.substr(0, chunk.end), last ? std::string_view{} : closingTag};
+            else
+                parts.parts = {layout->declaration, layout->rootStartTag,
+                               input.substr(chunk.begin, chunk.end - chunk.begin),
+                               last ? std::string_view{} : closingTag};
+            chunk.doc = xmlDocPtr_t{xmlReadIO(detail::readFromParts, nullptr, &parts, nullptr, nullptr, chunkOptions)};
+            const auto root = chunk.doc ? xmlDocGetRootElement(chunk.doc.get()) : nullptr;
+            if (!root || !hasQualifiedName(root, layout->rootName))
+                chunk.doc.reset();
+            // IDs are registered with the chunk's document and cannot be moved over.
+            else if (chunk.doc->ids != nullptr)
+                hasIds.store(true, std::memory_order_relaxed);
+        };
+
+        for (auto round = 0; round < 2; ++round)
+        {
+            runParallel(chunks.size(), this->threads, [&](const std::size_t index) {
+                if (!chunks[index].doc)
+                    parseChunk(chunks[index], index == 0);
+            });
+            if (std::ranges::all_of(chunks, [](const Chunk &chunk) { return chunk.doc != nullptr; }) &&
+                !hasIds.load(std::memory_order_relaxed))
+                break;
+            if (round == 1 || hasIds.load(std::memory_order_relaxed))
+            {
+                CPPLIBXML2_STATS_DISCARD_TIME();
+                return std::nullopt;
+            }
+
+            // A bad cut breaks the chunks on both sides; parse them again as one.
+            std::vector<Chunk> merged;
+            merged.reserve(chunks.size());
+            for (auto &chunk : chunks)
+            {
+                if (!merged.empty() && !merged.back().doc && !chunk.doc)
+                    merged.back().end = chunk.end;
+                else
+                    merged.push_back(std::move(chunk));
+            }
+            chunks = std::move(merged);
+        }
+
+        const auto target = chunks.front().doc.get();
+        const auto targetRoot = xmlDocGetRootElement(target);
+        const auto targetXmlNs = xmlSearchNs(target, targetRoot, reinterpret_cast<const xmlChar *>("xml"));
+        runParallel(chunks.size() - 1, this->threads, [&](const std::size_t index) {
+            const auto &chunk = chunks[index + 1];
+            adopt(chunk.doc.get(), xmlDocGetRootElement(chunk.doc.get()), target, targetRoot, targetXmlNs);
+        });
+
+        for (auto it = chunks.begin() + 1; it != chunks.end(); ++it)
+        {
+            const auto chunkRoot = xmlDocGetRootElement(it->doc.get());
+            if (chunkRoot->children)
+            {
+                if (targetRoot->last)
+                {
+                    targetRoot->last->next = chunkRoot->children;
+                    chunkRoot->children->prev = targetRoot->last;
+                }
+                else
+                    targetRoot->children = chunkRoot->children;
+                targetRoot->last = chunkRoot->last;
+                chunkRoot->children = nullptr;
+                chunkRoot->last = nullptr;
+            }
+            // Comments and processing instructions after the root.
+            while (const auto epilog = chunkRoot->next)
+            {
+                xmlUnlinkNode(epilog);
+                xmlAddChild(reinterpret_cast<xmlNodePtr>(target), epilog);
+            }
+        }
+
+        CPPLIBXML2_STATS_ADD(ParseCalls, 1);
+        CPPLIBXML2_STATS_ADD(BytesParsed, input.size());
+        chunksSpliced = chunks.size();
+        return detail::Access::makeDoc(std::move(chunks.front().doc));
+    }
+};
+
+ParallelParser::ParallelParser(const std::size_t threads, const ParserOptions options)
+    : impl(std::make_unique<Impl>())
+{
+    this->impl->threads = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    this->impl->options = options;
+}
+
+ParallelParser::ParallelParser(ParallelParser &&) noexcept = default;
+
+ParallelParser::~ParallelParser() = default;
+
+ParallelParser &ParallelParser::operator=(ParallelParser &&) noexcept = default;
+
+std::size_t ParallelParser::threads() const noexcept
+{
+    return this->impl->threads;
+}
+
+void ParallelParser::setMinChunkSize(const std::size_t bytes) noexcept
+{
+    this->impl->minChunkSize = std::max<std::size_t>(bytes, 1);
+}
+
+std::expected<Doc, RuntimeError> ParallelParser::parse(const std::string_view input,
+                                                       const std::string_view recordName) const
+{
+    initLibrary();
+    chunksSpliced = 0;
+    if (auto doc = this->impl->parse(input, recordName))
+        return std::move(*doc);
+    return Doc::parse(input, this->impl->options);
+}
+
+std::expected<Doc, RuntimeError> ParallelParser::parseFile(const std::filesystem::path &path,
+                                                           const std::string_view recordName) const
+{
+    initLibrary();
+    chunksSpliced = 0;
+    {
+        const auto file = MappedFile::open(path);
+        if (!file)
+            return std::unexpected{file.error()};
+        if (auto doc = this->impl->parse(file.value().view(), recordName))
+            return std::move(*doc);
+    }
+    // Serially with the file's URL, for relative DTD and entity lookups.
+    return Doc::parseMappedFile(path, this->impl->options);
+}
+
+std::size_t detail::lastChunkCount() noexcept
+{
+    return chunksSpliced;
+}
+} // namespace cpplibxml2
@@ -0,0 +1,105 @@
+#include "parser.hpp"
+
+#include "access.hpp"
+#include "helper.hpp"
+#include "inputIo.hpp"
+#include "instrumentation.hpp"
+
+#include <libxml/parser.h>
+
+namespace cpplibxml2
+{
+struct Parser::Impl
+{
+    xmlParserCtxtPtr_t ctxt;
+
+    [[nodiscard]] xmlParserCtxtPtr context() noexcept
+    {
+        if (!ctxt)
+        {
+            initLibrary();
+            ctxt.reset(xmlNewParserCtxt());
+        }
+        return ctxt.get();
+    }
+};
+
+Parser::Parser() : impl(std::make_unique<Impl>())
+{
+}
+
+Parser::Parser(Parser &&) noexcept = default;
+
+Parser::~Parser() = default;
+
+Parser &Parser::operator=(Parser &&) noexcept = default;
+
+Parser &Parser::local() noexcept
+{
+    thread_local Parser parser;
+    return parser;
+}
+
+std::expected<Doc, RuntimeError> Parser::parse(const std::string_view input, const ParserOptions options) noexcept
+{
+    CPPLIBXML2_STATS_TIME(Parse);
+    CPPLIBXML2_STATS_ADD(ParseCalls, 1);
+    CPPLIBXML2_STATS_ADD(BytesParsed, input.size());
+    if (input.empty())
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
+        return std::unexpected{RuntimeError{"Document is empty."}};
+    }
+
+    const auto ctxt = this->impl->context();
+    if (!ctxt)
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
+        return std::unexpected{RuntimeError{"Failed to create parser context."}};
+    }
+
+    // xmlCtxtReadMemory and xmlCtxtReadIO reset the context but keep its dictionary.
+    auto context = detail::MemoryInput{input};
+    auto doc = xmlDocPtr_t{
+        input.size() <= detail::maxMemoryInput
+            ? xmlCtxtReadMemory(ctxt, input.data(), static_cast<int>(input.size()), nullptr, nullptr,
+                                static_cast<int>(options))
+            : xmlCtxtReadIO(ctxt, detail::readFromMemory, nullptr, &context, nullptr, nullptr, static_cast<int>(options))};
+    if (!doc)
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
+        return std::unexpected{RuntimeError{"Document not parsed successfully."}};
+    }
+
+    return detail::Access::makeDoc(std::move(doc));
+}
+
+std::expected<Doc, RuntimeError> Parser::parseFile(const std::filesystem::path &path,
+                                                   const ParserOptions options) noexcept
+{
+    CPPLIBXML2_STATS_TIME(Parse);
+    CPPLIBXML2_STATS_ADD(ParseCalls, 1);
+    if (!std::filesystem::exists(path))
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
+        return std::unexpected{RuntimeError{"Document don't exist."}};
+    }
+    CPPLIBXML2_STATS_ADD(BytesParsed, detail::fileSize(path));
+
+    const auto ctxt = this->impl->context();
+    if (!ctxt)
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
+        return std::unexpected{RuntimeError{"Failed to create parser context."}};
+    }
+
+    auto doc = xmlDocPtr_t{xmlCtxtReadFile(ctxt, path.string().c_str(), nullptr, static_cast<int>(options))};
+    if (!doc)
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
+        return std::unexpected{RuntimeError{"Document not parsed successfully."}};
+    }
+
+    return detail::Access::makeDoc(std::move(doc));
+}
+} // namespace cpplibxml2
@@ -0,0 +1,394 @@
+#include "projection.hpp"
+
+#include "access.hpp"
+#include "helper.hpp"
+#include "inputIo.hpp"
+#include "instrumentation.hpp"
+
+#include <libxml/SAX2.h>
+#include <libxml/parser.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace cpplibxml2
+{
+namespace
+{
+/**
+ * A node of the path trie. Node 0 stands for the document, its children match the root element.
+ */
+struct Step
+{
+    std::string localName;
+    std::optional<std::string> nsUri; /* std::nullopt matches any namespace */
+    bool any = false;                 /* "*" */
+    bool selected = false;            /* a path ends here */
+    std::vector<std::size_t> children;
+
+    [[nodiscard]] bool sameStep(const Step &other) const noexcept
+    {
+        return this->any == other.any && this->localName == other.localName && this->nsUri == other.nsUri;
+    }
+
+    [[nodiscard]] bool matches(const std::string_view name, const std::string_view uri) const noexcept
+    {
+        return this->any || (this->localName == name && (!this->nsUri || *this->nsUri == uri));
+    }
+};
+
+/**
+ * @return The step, or std::nullopt if it is malformed
+ */
+std::optional<Step> parseStep(std::string_view text)
+{
+    Step step;
+    if (text == "*")
+    {
+        step.any = true;
+        return step;
+    }
+    if (text.starts_with('{'))
+    {
+        const auto close = text.find('}');
+        if (close == std::string_view::npos)
+            return std::nullopt;
+        step.nsUri = std::string{text.substr(1, close - 1)};
+        text.remove_prefix(close + 1);
+    }
+    if (text.empty() || text.find_first_of("{}:*") != std::string_view::npos)
+        return std::nullopt;
+    step.localName = text;
+    return step;
+}
+} // namespace
+
+struct Projection::Impl
+{
+    std::vector<Step> steps{1};
+
+    bool add(std::string_view path)
+    {
+        if (path.starts_with('/'))
+            path.remove_prefix(1);
+        if (path.empty())
+            return false;
+
+        std::size_t current = 0;
+        while (true)
+        {
+            // A '/' inside "{uri}" does not end the step.
+            const auto uriEnd = path.starts_with('{') ? path.find('}') : 0;
+            const auto slash = path.find('/', uriEnd == std::string_view::npos ? 0 : uriEnd);
+            auto step = parseStep(path.substr(0, slash));
+            if (!step)
+                return false;
+
+            const auto &children = this->steps[current].children;
+            const auto existing = std::ranges::find_if(
+                children, [this, &step](const std::size_t child) { return this->steps[child].sameStep(*step); });
+            if (existing != children.end())
+                current = *existing;
+            else
+            {
+                this->steps.push_back(std::move(*step));
+                this->steps[current].children.push_back(this->steps.size() - 1);
+                current = this->steps.size() - 1;
+            }
+
+            if (slash == std::string_view::npos)
+                break;
+            path.remove_prefix(slash + 1);
+        }
+        this->steps[current].selected = true;
+        return true;
+    }
+};
+
+namespace
+{
+/**
+ * Per-parse filter between libxml2 and its SAX2 tree builder.
+ *
+ * Every kept element that is not selected itself opens a frame: the trie steps it matched, whose children its own
+ * children are matched against. Selected subtrees and dropped subtrees are only counted.
+ */
+struct Filter
+{
+    struct Frame
+    {
+        std::size_t activeBegin; /* start of the frame's steps in `active` */
+        std::size_t keptBegin;   /* start of the frame's children in `kept` */
+    };
+
+    const std::vector<Step> *steps = nullptr;
+    std::vector<std::size_t> active{0};
+    std::vector<Frame> frames{{0, 0}};
+    // Children of the open frame elements that were passed to the tree builder.
+    std::vector<xmlNodePtr> kept;
+    std::size_t keepDepth = 0;
+    std::size_t skipDepth = 0;
+    // The innermost open frame element. libxml2 also builds the content of entities through the SAX2 callbacks,
+    // under a node of its own; events while the tree builder is elsewhere are passed through unfiltered.
+    xmlNodePtr parent = nullptr;
+
+    /**
+     * Removes the children of the closing frame element that were not passed to the tree builder. When it replaces
+     * entity references, libxml2 copies the entity content into the current element directly, bypassing SAX.
+     */
+    void prune() noexcept
+    {
+        auto next = this->kept.begin() + static_cast<std::ptrdiff_t>(this->frames.back().keptBegin);
+        for (auto child = this->parent->children; child;)
+        {
+            const auto following = child->next;
+            if (next != this->kept.end() && child == *next)
+                ++next;
+            else
+            {
+                xmlUnlinkNode(child);
+                xmlFreeNode(child);
+            }
+            child = following;
+        }
+    }
+
+    /**
+     * @return Whether the event belongs to a selected subtree or to entity content
+     */
+    [[nodiscard]] bool passThrough(const xmlParserCtxt *ctxt) const noexcept
+    {
+        return this->keepDepth > 0 || currentNode(ctxt) != this->parent;
+    }
+};
+
+Filter &filter(void *ctx) noexcept
+{
+    return *static_cast<Filter *>(static_cast<xmlParserCtxtPtr>(ctx)->_private);
+}
+
+void onStartElement(void *ctx, const xmlChar *localName, const xmlChar *prefix, const xmlChar *uri,
+                    const int nbNamespaces, const xmlChar **namespaces, const int nbAttributes, const int nbDefaulted,
+                    const xmlChar **attributes)
+{
+    const auto ctxt = static_cast<xmlParserCtxtPtr>(ctx);
+    auto &f = filter(ctx);
+    const auto forward = [&] {
+        xmlSAX2StartElementNs(ctx, localName, prefix, uri, nbNamespaces, namespaces, nbAttributes, nbDefaulted,
+                              attributes);
+    };
+    if (f.passThrough(ctxt))
+    {
+        f.keepDepth += f.keepDepth > 0 ? 1 : 0;
+        forward();
+        return;
+    }
+    if (f.skipDepth > 0)
+    {
+        ++f.skipDepth;
+        return;
+    }
+
+    const auto name = toStringView(localName);
+    const auto href = toStringView(uri);
+    const auto parentEnd = f.active.size();
+    bool selected = false;
+    for (auto i = f.frames.back().activeBegin; i < parentEnd; ++i)
+    {
+        for (const auto child : (*f.steps)[f.active[i]].children)
+        {
+            const auto &step = (*f.steps)[child];
+            if (!step.matches(name, href))
+                continue;
+            selected = selected || step.selected;
+            f.active.push_back(child);
+        }
+    }
+
+    const bool root = f.frames.size() == 1;
+    if (!selected && f.active.size() == parentEnd && !root)
+    {
+        f.skipDepth = 1;
+        return;
+    }
+    forward();
+    f.kept.push_back(currentNode(ctxt));
+    if (selected)
+    {
+        f.active.resize(parentEnd);
+        f.keepDepth = 1;
+        return;
+    }
+    f.frames.push_back({parentEnd, f.kept.size()});
+    f.parent = currentNode(ctxt);
+}
+
+void onEndElement(void *ctx, const xmlChar *localName, const xmlChar *prefix, const xmlChar *uri)
+{
+    const auto ctxt = static_cast<xmlParserCtxtPtr>(ctx);
+    auto &f = filter(ctx);
+    if (f.passThrough(ctxt))
+    {
+        f.keepDepth -= f.keepDepth > 0 ? 1 : 0;
+        xmlSAX2EndElementNs(ctx, localName, prefix, uri);
+        return;
+    }
+    if (f.skipDepth > 0)
+    {
+        --f.skipDepth;
+        return;
+    }
+    f.prune();
+    const auto frame = f.frames.back();
+    f.frames.pop_back();
+    f.active.resize(frame.activeBegin);
+    f.kept.resize(frame.keptBegin);
+    xmlSAX2EndElementNs(ctx, localName, prefix, uri);
+    f.parent = currentNode(ctxt);
+}
+
+void onCharacters(void *ctx, const xmlChar *text, const int len)
+{
+    if (filter(ctx).passThrough(static_cast<xmlParserCtxtPtr>(ctx)))
+        xmlSAX2Characters(ctx, text, len);
+}
+
+void onCData(void *ctx, const xmlChar *text, const int len)
+{
+    if (filter(ctx).passThrough(static_cast<xmlParserCtxtPtr>(ctx)))
+        xmlSAX2CDataBlock(ctx, text, len);
+}
+
+void onComment(void *ctx, const xmlChar *text)
+{
+    if (filter(ctx).passThrough(static_cast<xmlParserCtxtPtr>(ctx)))
+        xmlSAX2Comment(ctx, text);
+}
+
+void onProcessingInstruction(void *ctx, const xmlChar *target, const xmlChar *data)
+{
+    if (filter(ctx).passThrough(static_cast<xmlParserCtxtPtr>(ctx)))
+        xmlSAX2ProcessingInstruction(ctx, target, data);
+}
+
+void onReference(void *ctx, const xmlChar *name)
+{
+    if (filter(ctx).passThrough(static_cast<xmlParserCtxtPtr>(ctx)))
+        xmlSAX2Reference(ctx, name);
+}
+
+xmlSAXHandler makeHandler() noexcept
+{
+    // The SAX2 tree builder, with the content callbacks routed through the filter.
+    xmlSAXHandler sax{};
+    xmlSAXVersion(&sax, 2);
+    sax.startElementNs = onStartElement;
+    sax.endElementNs = onEndElement;
+    // The SAX1 element callbacks would build unfiltered elements; run() never lets libxml2 use them.
+    sax.startElement = nullptr;
+    sax.endElement = nullptr;
+    sax.characters = onCharacters;
+    sax.ignorableWhitespace = onCharacters;
+    sax.cdataBlock = onCData;
+    sax.comment = onComment;
+    sax.processingInstruction = onProcessingInstruction;
+    sax.reference = onReference;
+    return sax;
+}
+
+template <typename ReadFunc>
+std::expected<Doc, RuntimeError> run(const std::vector<Step> &steps, const ParserOptions options,
+                                     ReadFunc &&read) noexcept
+{
+    initLibrary();
+
+    const auto sax = makeHandler();
+    const auto ctxt = xmlParserCtxtPtr_t{xmlNewSAXParserCtxt(&sax, nullptr)};
+    if (!ctxt)
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
+        return std::unexpected{RuntimeError{"Failed to create parser context."}};
+    }
+
+    Filter state;
+    state.steps = &steps;
+    ctxt->_private = &state;
+
+    // With XML_PARSE_SAX1 libxml2 would report elements through the SAX1 callbacks, which the filter does not see.
+    auto doc = xmlDocPtr_t{read(ctxt.get(), static_cast<int>(options & ~ParserOptions::XML_PARSE_SAX1))};
+    if (!doc)
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
+        return std::unexpected{RuntimeError{"Document not parsed successfully."}};
+    }
+    return detail::Access::makeDoc(std::move(doc));
+}
+} // namespace
+
+Projection::Projection() : impl(std::make_unique<Impl>())
+{
+}
+
+Projection::Projection(Projection &&) noexcept = default;
+
+Projection::~Projection() = default;
+
+Projection &Projection::operator=(Projection &&) noexcept = default;
+
+std::expected<Projection, RuntimeError> Projection::create(const std::span<const std::string_view> paths)
+{
+    auto result = Projection{};
+    for (const auto path : paths)
+    {
+        if (!result.impl->add(path))
+            return std::unexpected{RuntimeError{"Invalid projection path."}};
+    }
+    return result;
+}
+
+std::expected<Projection, RuntimeError> Projection::create(const std::initializer_list<std::string_view> paths)
+{
+    return create(std::span{paths.begin(), paths.size()});
+}
+
+std::expected<Doc, RuntimeError> Projection::parse(const std::string_view input,
+                                                   const ParserOptions options) const noexcept
+{
+    CPPLIBXML2_STATS_TIME(Parse);
+    CPPLIBXML2_STATS_ADD(ParseCalls, 1);
+    CPPLIBXML2_STATS_ADD(BytesParsed, input.size());
+    if (input.empty())
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
+        return std::unexpected{RuntimeError{"Document is empty."}};
+    }
+
+    return run(this->impl->steps, options, [input](xmlParserCtxtPtr ctxt, const int libxmlOptions) {
+        if (input.size() <= detail::maxMemoryInput)
+            return xmlCtxtReadMemory(ctxt, input.data(), static_cast<int>(input.size()), nullptr, nullptr,
+                                     libxmlOptions);
+        auto context = detail::MemoryInput{input};
+        return xmlCtxtReadIO(ctxt, detail::readFromMemory, nullptr, &context, nullptr, nullptr, libxmlOptions);
+    });
+}
+
+std::expected<Doc, RuntimeError> Projection::parseFile(const std::filesystem::path &path,
+                                                       const ParserOptions options) const noexcept
+{
+    CPPLIBXML2_STATS_TIME(Parse);
+    CPPLIBXML2_STATS_ADD(ParseCalls, 1);
+    if (!std::filesystem::exists(path))
+    {
+        CPPLIBXML2_STATS_ADD(ParseFailures, 1);
+        return std::unexpected{RuntimeError{"Document don't exist."}};
+    }
+    CPPLIBXML2_STATS_ADD(BytesParsed, detail::fileSize(path));
+
+    const auto fileName = path.string();
+    return run(this->impl->steps, options, [&fileName](xmlParserCtxtPtr ctxt, const int libxmlOptions) {
+        return xmlCtxtReadFile(ctxt, fileName.c_str(), nullptr, libxmlOptions);
+    });
+}
+} // namespace cpplibxml2
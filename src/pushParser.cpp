@@ -0,0 +1,91 @@
+#include "pushParser.hpp"
+
+#include "access.hpp"
+#include "helper.hpp"
+
+#include <libxml/parser.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace cpplibxml2
+{
+struct PushParser::Impl
+{
+    xmlParserCtxtPtr_t ctxt;
+    ParserOptions options;
+    bool failed = false;
+
+    [[nodiscard]] bool recover() const noexcept
+    {
+        return (options & ParserOptions::Recover) == ParserOptions::Recover;
+    }
+};
+
+PushParser::PushParser() : impl(std::make_unique<Impl>())
+{
+}
+
+PushParser::PushParser(PushParser &&) noexcept = default;
+
+PushParser::~PushParser() = default;
+
+PushParser &PushParser::operator=(PushParser &&) noexcept = default;
+
+std::expected<PushParser, RuntimeError> PushParser::create(const ParserOptions options) noexcept
+{
+    initLibrary();
+
+    auto ctxt = xmlParserCtxtPtr_t{xmlCreatePushParserCtxt(nullptr, nullptr, nullptr, 0, nullptr)};
+    if (!ctxt)
+        return std::unexpected{RuntimeError{"Failed to create parser context."}};
+    xmlCtxtUseOptions(ctxt.get(), static_cast<int>(options));
+
+    auto result = PushParser{};
+    result.impl->ctxt = std::move(ctxt);
+    result.impl->options = options;
+    return result;
+}
+
+std::expected<void, RuntimeError> PushParser::feed(std::string_view chunk) noexcept
+{
+    if (this->impl->failed)
+        return std::unexpected{RuntimeError{"Document not parsed successfully."}};
+
+    // xmlParseChunk takes an int size.
+    constexpr auto maxChunk = static_cast<std::size_t>(std::numeric_limits<int>::max());
+    while (!chunk.empty())
+    {
+        const auto size = std::min(chunk.size(), maxChunk);
+        xmlParseChunk(this->impl->ctxt.get(), chunk.data(), static_cast<int>(size), 0);
+        chunk.remove_prefix(size);
+
+        if (!isWellFormed(this->impl->ctxt.get()) && !this->impl->recover())
+        {
+            this->impl->failed = true;
+            return std::unexpected{RuntimeError{"Document not parsed successfully."}};
+        }
+    }
+    return {};
+}
+
+std::expected<Doc, RuntimeError> PushParser::finish() noexcept
+{
+    const auto ctxt = this->impl->ctxt.get();
+    if (!this->impl->failed)
+        xmlParseChunk(ctxt, nullptr, 0, 1);
+
+    const bool wellFormed = !this->impl->failed && isWellFormed(ctxt);
+    auto doc = takeDocument(ctxt);
+
+    // Get ready for the next document.
+    xmlCtxtResetPush(ctxt, nullptr, 0, nullptr, nullptr);
+    xmlCtxtUseOptions(ctxt, static_cast<int>(this->impl->options));
+    this->impl->failed = false;
+
+    if (!doc || (!wellFormed && !this->impl->recover()))
+        return std::unexpected{RuntimeError{"Document not parsed successfully."}};
+
+    return detail::Access::makeDoc(std::move(doc));
+}
+} // namespace cpplibxml2
@@ -0,0 +1,214 @@
+#include "reader.hpp"
+
+#include "access.hpp"
+#include "helper.hpp"
+#include "inputIo.hpp"
+
+#include <libxml/xmlreader.h>
+
+namespace cpplibxml2
+{
+struct Reader::Impl
+{
+    // Read position in inputs beyond 2 GiB, which are fed to the reader in chunks.
+    detail::MemoryInput input;
+    xmlTextReaderPtr_t reader;
+};
+
+namespace
+{
+std::expected<bool, RuntimeError> toReadResult(const int rc)
+{
+    if (rc < 0)
+        return std::unexpected{RuntimeError{"Document not read successfully."}};
+    return rc == 1;
+}
+
+xmlNodePtr currentElement(xmlTextReaderPtr reader) noexcept
+{
+    auto node = xmlTextReaderCurrentNode(reader);
+    if (node && node->type == XML_ATTRIBUTE_NODE)
+        node = node->parent;
+    return node && node->type == XML_ELEMENT_NODE ? node : nullptr;
+}
+} // namespace
+
+Reader::Reader() : impl(std::make_unique<Impl>())
+{
+}
+
+Reader::Reader(Reader &&) noexcept = default;
+
+Reader::~Reader() = default;
+
+Reader &Reader::operator=(Reader &&) noexcept = default;
+
+std::expected<Reader, RuntimeError> Reader::openFile(const std::filesystem::path &path,
+                                                     const ParserOptions options) noexcept
+{
+    initLibrary();
+
+    if (!std::filesystem::exists(path))
+        return std::unexpected{RuntimeError{"Document don't exist."}};
+
+    auto reader = xmlTextReaderPtr_t{xmlReaderForFile(path.string().c_str(), nullptr, static_cast<int>(options))};
+    if (!reader)
+        return std::unexpected{RuntimeError{"Failed to create reader."}};
+
+    auto result = Reader{};
+    result.impl->reader = std::move(reader);
+    return result;
+}
+
+std::expected<Reader, RuntimeError> Reader::open(const std::string_view input, const ParserOptions options) noexcept
+{
+    initLibrary();
+
+    if (input.empty())
+        return std::unexpected{RuntimeError{"Document is empty."}};
+
+    auto result = Reader{};
+    auto &state = *result.impl;
+    if (input.size() <= detail::maxMemoryInput)
+    {
+        state.reader = xmlTextReaderPtr_t{xmlReaderForMemory(input.data(), static_cast<int>(input.size()), nullptr,
+                                                             nullptr, static_cast<int>(options))};
+    }
+    else
+    {
+        state.input.rest = input;
+        state.reader = xmlTextReaderPtr_t{
+            xmlReaderForIO(detail::readFromMemory, nullptr, &state.input, nullptr, nullptr, static_cast<int>(options))};
+    }
+    if (!state.reader)
+        return std::unexpected{RuntimeError{"Failed to create reader."}};
+    return result;
+}
+
+std::expected<bool, RuntimeError> Reader::read() noexcept
+{
+    return toReadResult(xmlTextReaderRead(this->impl->reader.get()));
+}
+
+std::expected<bool, RuntimeError> Reader::next() noexcept
+{
+    return toReadResult(xmlTextReaderNext(this->impl->reader.get()));
+}
+
+ReaderNodeType Reader::nodeType() const noexcept
+{
+    const auto type = xmlTextReaderNodeType(this->impl->reader.get());
+    return type < 0 ? ReaderNodeType::None : static_cast<ReaderNodeType>(type);
+}
+
+int Reader::depth() const noexcept
+{
+    return xmlTextReaderDepth(this->impl->reader.get());
+}
+
+bool Reader::isEmptyElement() const noexcept
+{
+    return xmlTextReaderIsEmptyElement(this->impl->reader.get()) == 1;
+}
+
+std::string_view Reader::name() const noexcept
+{
+    return toStringView(xmlTextReaderConstName(this->impl->reader.get()));
+}
+
+std::string_view Reader::localName() const noexcept
+{
+    return toStringView(xmlTextReaderConstLocalName(this->impl->reader.get()));
+}
+
+std::string_view Reader::prefix() const noexcept
+{
+    return toStringView(xmlTextReaderConstPrefix(this->impl->reader.get()));
+}
+
+std::string_view Reader::namespaceUri() const noexcept
+{
+    return toStringView(xmlTextReaderConstNamespaceUri(this->impl->reader.get()));
+}
+
+std::string_view Reader::value() const noexcept
+{
+    return toStringView(xmlTextReaderConstValue(this->impl->reader.get()));
+}
+
+int Reader::attributeCount() const noexcept
+{
+    return xmlTextReaderAttributeCount(this->impl->reader.get());
+}
+
+std::optional<std::string_view> Reader::attribute(const std::string_view name) const noexcept
+{
+    const auto element = currentElement(this->impl->reader.get());
+    if (!element)
+        return std::nullopt;
+
+    for (auto attr = element->properties; attr; attr = attr->next)
+    {
+        if (toStringView(attr->name) == name)
+            return attributeValue(attr);
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string_view> Reader::attribute(const std::string_view name,
+                                                  const std::string_view nsUri) const noexcept
+{
+    const auto element = currentElement(this->impl->reader.get());
+    if (!element)
+        return std::nullopt;
+
+    for (auto attr = element->properties; attr; attr = attr->next)
+    {
+        const std::string_view href = attr->ns ? toStringView(attr->ns->href) : std::string_view{};
+        if (toStringView(attr->name) == name && href == nsUri)
+            return attributeValue(attr);
+    }
+    return std::nullopt;
+}
+
+bool Reader::moveToFirstAttribute() noexcept
+{
+    return xmlTextReaderMoveToFirstAttribute(this->impl->reader.get()) == 1;
+}
+
+bool Reader::moveToNextAttribute() noexcept
+{
+    return xmlTextReaderMoveToNextAttribute(this->impl->reader.get()) == 1;
+}
+
+bool Reader::moveToElement() noexcept
+{
+    return xmlTextReaderMoveToElement(this->impl->reader.get()) == 1;
+}
+
+std::expected<Node, RuntimeError> Reader::expand() noexcept
+{
+    const auto node = xmlTextReaderExpand(this->impl->reader.get());
+    if (!node)
+        return std::unexpected{RuntimeError{"Failed to expand node."}};
+    return detail::Access::makeNode(node);
+}
+
+std::expected<Doc, RuntimeError> Reader::expandDoc() noexcept
+{
+    const auto node = xmlTextReaderExpand(this->impl->reader.get());
+    if (!node || node->type != XML_ELEMENT_NODE)
+        return std::unexpected{RuntimeError{"Failed to expand node."}};
+
+    auto doc = xmlDocPtr_t{xmlNewDoc(reinterpret_cast<const xmlChar *>("1.0"))};
+    if (!doc)
+        return std::unexpected{RuntimeError{"Failed to create document."}};
+
+    const auto copy = xmlDocCopyNode(node, doc.get(), 1);
+    if (!copy)
+        return std::unexpected{RuntimeError{"Failed to copy node."}};
+    xmlDocSetRootElement(doc.get(), copy);
+
+    return detail::Access::makeDoc(std::move(doc));
+}
+} // namespace cpplibxml2
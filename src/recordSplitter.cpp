@@ -0,0 +1,317 @@
+#include "recordSplitter.hpp"
+
+#include "reader.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cpplibxml2
+{
+struct RecordSplitter::Impl
+{
+    std::optional<Reader> reader;
+    std::string recordName;
+    std::string nsUri;
+    // Records handed out so far, the index of the next one.
+    std::size_t index = 0;
+    // Set when skipping a record already moved the cursor onto the next node to look at.
+    bool advanced = false;
+    bool done = false;
+    // An error while skipping past a record, reported after that record.
+    std::optional<RuntimeError> pendingError;
+
+    [[nodiscard]] bool atRecord() const noexcept
+    {
+        return this->reader->nodeType() == ReaderNodeType::StartElement &&
+               this->reader->localName() == this->recordName &&
+               (this->nsUri.empty() || this->reader->namespaceUri() == this->nsUri);
+    }
+
+    std::expected<std::optional<Doc>, RuntimeError> next()
+    {
+        if (this->pendingError)
+        {
+            this->done = true;
+            return std::unexpected{*std::exchange(this->pendingError, std::nullopt)};
+        }
+        if (this->done)
+            return std::nullopt;
+
+        while (true)
+        {
+            const auto moved = this->advanced ? std::expected<bool, RuntimeError>{true} : this->reader->read();
+            this->advanced = false;
+            if (!moved || !moved.value())
+            {
+                this->done = true;
+                if (!moved)
+                    return std::unexpected{moved.error()};
+                return std::nullopt;
+            }
+            if (!this->atRecord())
+                continue;
+
+            auto record = this->reader->expandDoc();
+            if (!record)
+            {
+                this->done = true;
+                return std::unexpected{record.error()};
+            }
+            // Skips the subtree, so the reader can free it, and lands on the node after the record.
+            if (const auto skipped = this->reader->next(); skipped)
+            {
+                this->advanced = skipped.value();
+                this->done = !skipped.value();
+            }
+            else
+                this->pendingError = skipped.error();
+            ++this->index;
+            return std::optional<Doc>{std::move(record.value())};
+        }
+    }
+};
+
+RecordSplitter::RecordSplitter() : impl(std::make_unique<Impl>())
+{
+}
+
+RecordSplitter::RecordSplitter(RecordSplitter &&) noexcept = default;
+
+RecordSplitter::~RecordSplitter() = default;
+
+RecordSplitter &RecordSplitter::operator=(RecordSplitter &&) noexcept = default;
+
+std::expected<RecordSplitter, RuntimeError> RecordSplitter::openFile(const std::filesystem::path &path,
+                                                                     const std::string_view recordName,
+                                                                     const std::string_view nsUri,
+                                                                     const ParserOptions options) noexcept
+{
+    if (recordName.empty())
+        return std::unexpected{RuntimeError{"Record name is empty."}};
+    auto reader = Reader::openFile(path, options);
+    if (!reader)
+        return std::unexpected{reader.error()};
+
+    auto result = RecordSplitter{};
+    result.impl->reader.emplace(std::move(reader.value()));
+    result.impl->recordName = recordName;
+    result.impl->nsUri = nsUri;
+    return result;
+}
+
+std::expected<RecordSplitter, RuntimeError> RecordSplitter::open(const std::string_view input,
+                                                                 const std::string_view recordName,
+                                                                 const std::string_view nsUri,
+                                                                 const ParserOptions options) noexcept
+{
+    if (recordName.empty())
+        return std::unexpected{RuntimeError{"Record name is empty."}};
+    auto reader = Reader::open(input, options);
+    if (!reader)
+        return std::unexpected{reader.error()};
+
+    auto result = RecordSplitter{};
+    result.impl->reader.emplace(std::move(reader.value()));
+    result.impl->recordName = recordName;
+    result.impl->nsUri = nsUri;
+    return result;
+}
+
+std::expected<std::optional<Doc>, RuntimeError> RecordSplitter::next()
+{
+    return this->impl->next();
+}
+
+std::expected<std::size_t, RuntimeError> RecordSplitter::forEach(const Callback &callback)
+{
+    std::size_t count = 0;
+    while (true)
+    {
+        auto record = this->impl->next();
+        if (!record)
+            return std::unexpected{record.error()};
+        if (!record.value())
+            return count;
+        callback(this->impl->index - 1, std::move(*record.value()));
+        ++count;
+    }
+}
+
+std::expected<std::size_t, RuntimeError> RecordSplitter::forEach(const Callback &callback, const std::size_t threads,
+                                                                 const RecordOrder order)
+{
+    if (order == RecordOrder::Unordered)
+    {
+        return this->dispatch(threads, order, [&callback](const std::size_t index, Doc &&record) -> Delivery {
+            callback(index, std::move(record));
+            return {};
+        });
+    }
+    return this->dispatch(threads, order, [&callback](const std::size_t index, Doc &&record) -> Delivery {
+        return [&callback, index, doc = std::move(record)]() mutable { callback(index, std::move(doc)); };
+    });
+}
+
+namespace
+{
+// Records are handed to the workers in batches, small records are cheaper to read than to hand over one by one. The
+// batches start with a single record so the workers get going quickly and double up to this size.
+constexpr std::size_t maxBatch = 64;
+
+using Batch = std::vector<std::pair<std::size_t, Doc>>;
+} // namespace
+
+std::expected<std::size_t, RuntimeError> RecordSplitter::dispatch(
+    const std::size_t threads, const RecordOrder order, const std::function<Delivery(std::size_t, Doc &&)> &process)
+{
+    const auto workers = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    // Records read but not yet delivered. Bounds the queue, and with ordered delivery the results waiting for a slow
+    // record before them.
+    const auto window = 2 * workers * maxBatch;
+
+    std::mutex mutex;
+    std::condition_variable available;
+    std::condition_variable space;
+    std::deque<Batch> queue;
+    std::size_t inFlight = 0;
+    bool finished = false;
+    std::exception_ptr failure;
+
+    std::mutex deliveryMutex;
+    std::map<std::size_t, Delivery> pending;
+    auto nextDelivery = this->impl->index;
+
+    const auto stop = [&](std::exception_ptr exception) {
+        const std::lock_guard lock{mutex};
+        if (!failure)
+            failure = std::move(exception);
+        available.notify_all();
+        space.notify_all();
+    };
+
+    // Runs the deliveries that are due and returns how many records that completed.
+    const auto deliver = [&](std::vector<std::pair<std::size_t, Delivery>> &processed) -> std::size_t {
+        const std::lock_guard lock{deliveryMutex};
+        if (order == RecordOrder::Unordered)
+        {
+            for (auto &[index, delivery] : processed)
+            {
+                if (delivery)
+                    delivery();
+            }
+            return processed.size();
+        }
+        for (auto &[index, delivery] : processed)
+            pending.emplace(index, std::move(delivery));
+        std::size_t delivered = 0;
+        for (auto it = pending.begin(); it != pending.end() && it->first == nextDelivery; it = pending.begin())
+        {
+            auto due = std::move(it->second);
+            pending.erase(it);
+            ++nextDelivery;
+            ++delivered;
+            if (due)
+                due();
+        }
+        return delivered;
+    };
+
+    const auto work = [&] {
+        std::vector<std::pair<std::size_t, Delivery>> processed;
+        while (true)
+        {
+            std::unique_lock lock{mutex};
+            available.wait(lock, [&] { return !queue.empty() || finished || failure; });
+            if (failure || queue.empty())
+                return;
+            auto batch = std::move(queue.front());
+            queue.pop_front();
+            lock.unlock();
+
+            try
+            {
+                processed.clear();
+                for (auto &[index, record] : batch)
+                    processed.emplace_back(index, process(index, std::move(record)));
+                const auto delivered = deliver(processed);
+                lock.lock();
+                inFlight -= delivered;
+                space.notify_one();
+            }
+            catch (...)
+            {
+                stop(std::current_exception());
+                return;
+            }
+        }
+    };
+
+    std::size_t count = 0;
+    std::optional<RuntimeError> error;
+    {
+        std::vector<std::jthread> pool;
+        pool.reserve(workers);
+        for (std::size_t i = 0; i < workers; ++i)
+            pool.emplace_back(work);
+
+        Batch batch;
+        std::size_t batchSize = 1;
+        const auto submit = [&] {
+            const std::lock_guard lock{mutex};
+            inFlight += batch.size();
+            queue.push_back(std::exchange(batch, {}));
+            batchSize = std::min(2 * batchSize, maxBatch);
+            available.notify_one();
+        };
+
+        try
+        {
+            while (true)
+            {
+                if (batch.empty())
+                {
+                    std::unique_lock lock{mutex};
+                    space.wait(lock, [&] { return inFlight < window || failure; });
+                    if (failure)
+                        break;
+                }
+                auto record = this->impl->next();
+                if (!record)
+                {
+                    error = record.error();
+                    break;
+                }
+                if (!record.value())
+                    break;
+
+                batch.emplace_back(this->impl->index - 1, std::move(*record.value()));
+                ++count;
+                if (batch.size() == batchSize)
+                    submit();
+            }
+            if (!batch.empty())
+                submit();
+        }
+        catch (...)
+        {
+            stop(std::current_exception());
+        }
+
+        const std::lock_guard lock{mutex};
+        finished = true;
+        available.notify_all();
+    }
+
+    if (failure)
+        std::rethrow_exception(failure);
+    if (error)
+        return std::unexpected{*error};
+    return count;
+}
+} // namespace cpplibxml2
@@ -0,0 +1,184 @@
+#include "saxParser.hpp"
+
+#include "helper.hpp"
+#include "inputIo.hpp"
+
+#include <libxml/SAX2.h>
+#include <libxml/parser.h>
+
+#include <vector>
+
+namespace cpplibxml2::detail
+{
+namespace
+{
+struct SaxState
+{
+    const SaxCallbacks *callbacks = nullptr;
+    void *handler = nullptr;
+    std::vector<SaxNamespace> namespaces;
+    std::vector<SaxAttribute> attributes;
+    bool failed = false;
+};
+
+SaxState &state(void *ctx) noexcept
+{
+    return *static_cast<SaxState *>(static_cast<xmlParserCtxtPtr>(ctx)->_private);
+}
+
+void onStartDocument(void *ctx)
+{
+    // Keeps the DTD bookkeeping of the default handler so entities can be resolved.
+    xmlSAX2StartDocument(ctx);
+    auto &s = state(ctx);
+    s.callbacks->startDocument(s.handler);
+}
+
+void onEndDocument(void *ctx)
+{
+    auto &s = state(ctx);
+    s.callbacks->endDocument(s.handler);
+}
+
+void onStartElement(void *ctx, const xmlChar *localName, const xmlChar *prefix, const xmlChar *uri,
+                    const int nbNamespaces, const xmlChar **namespaces, const int nbAttributes, int,
+                    const xmlChar **attributes)
+{
+    auto &s = state(ctx);
+
+    s.namespaces.clear();
+    for (int i = 0; i < nbNamespaces; ++i)
+    {
+        const auto ns = namespaces + 2 * i;
+        s.namespaces.push_back({toStringView(ns[0]), toStringView(ns[1])});
+    }
+
+    // libxml2 passes localname/prefix/URI/value/end quintuples; the value is not null-terminated.
+    s.attributes.clear();
+    for (int i = 0; i < nbAttributes; ++i)
+    {
+        const auto attr = attributes + 5 * i;
+        s.attributes.push_back({toStringView(attr[0]), toStringView(attr[1]), toStringView(attr[2]),
+                                toStringView(attr[3], static_cast<int>(attr[4] - attr[3]))});
+    }
+
+    s.callbacks->startElement(s.handler, toStringView(localName), toStringView(prefix), toStringView(uri),
+                              s.namespaces, s.attributes);
+}
+
+void onEndElement(void *ctx, const xmlChar *localName, const xmlChar *prefix, const xmlChar *uri)
+{
+    auto &s = state(ctx);
+    s.callbacks->endElement(s.handler, toStringView(localName), toStringView(prefix), toStringView(uri));
+}
+
+void onCharacters(void *ctx, const xmlChar *text, const int len)
+{
+    auto &s = state(ctx);
+    s.callbacks->characters(s.handler, toStringView(text, len));
+}
+
+void onCData(void *ctx, const xmlChar *text, const int len)
+{
+    auto &s = state(ctx);
+    s.callbacks->cdata(s.handler, toStringView(text, len));
+}
+
+void onComment(void *ctx, const xmlChar *text)
+{
+    auto &s = state(ctx);
+    s.callbacks->comment(s.handler, toStringView(text));
+}
+
+void onProcessingInstruction(void *ctx, const xmlChar *target, const xmlChar *data)
+{
+    auto &s = state(ctx);
+    s.callbacks->processingInstruction(s.handler, toStringView(target), toStringView(data));
+}
+
+void onError(void *ctx, const xmlError *error)
+{
+    if (error && error->level >= XML_ERR_ERROR)
+        state(ctx).failed = true;
+}
+
+xmlSAXHandler makeHandler(const SaxCallbacks &callbacks) noexcept
+{
+    // Start from the SAX2 defaults for DTD and entity handling, but never build a tree.
+    xmlSAXHandler sax{};
+    xmlSAXVersion(&sax, 2);
+    sax.startElement = nullptr;
+    sax.endElement = nullptr;
+    sax.reference = nullptr;
+    sax.startElementNs = callbacks.startElement ? onStartElement : nullptr;
+    sax.endElementNs = callbacks.endElement ? onEndElement : nullptr;
+    sax.characters = callbacks.characters ? onCharacters : nullptr;
+    sax.ignorableWhitespace = sax.characters;
+    sax.cdataBlock = callbacks.cdata ? onCData : nullptr;
+    sax.comment = callbacks.comment ? onComment : nullptr;
+    sax.processingInstruction = callbacks.processingInstruction ? onProcessingInstruction : nullptr;
+    if (callbacks.startDocument)
+        sax.startDocument = onStartDocument;
+    sax.endDocument = callbacks.endDocument ? onEndDocument : nullptr;
+    sax.serror = onError;
+    return sax;
+}
+
+int toLibxmlOptions(const ParserOptions options) noexcept
+{
+    // Errors are collected by onError, so libxml2 must not suppress them before they reach it.
+    return static_cast<int>(options & ~(ParserOptions::NoError | ParserOptions::NoWarning));
+}
+
+template <typename ReadFunc>
+std::expected<void, RuntimeError> run(const SaxCallbacks &callbacks, void *handler, const ParserOptions options,
+                                      ReadFunc &&read) noexcept
+{
+    initLibrary();
+
+    const auto sax = makeHandler(callbacks);
+    const auto ctxt = xmlParserCtxtPtr_t{xmlNewSAXParserCtxt(&sax, nullptr)};
+    if (!ctxt)
+        return std::unexpected{RuntimeError{"Failed to create parser context."}};
+
+    SaxState saxState;
+    saxState.callbacks = &callbacks;
+    saxState.handler = handler;
+    ctxt->_private = &saxState;
+
+    // Only the DTD bookkeeping ends up in this document.
+    const auto doc = xmlDocPtr_t{read(ctxt.get(), toLibxmlOptions(options))};
+
+    if (saxState.failed && (options & ParserOptions::Recover) != ParserOptions::Recover)
+        return std::unexpected{RuntimeError{"Document not parsed successfully."}};
+    return {};
+}
+} // namespace
+
+std::expected<void, RuntimeError> saxParse(const std::string_view input, const SaxCallbacks &callbacks, void *handler,
+                                           const ParserOptions options) noexcept
+{
+    if (input.empty())
+        return std::unexpected{RuntimeError{"Document is empty."}};
+
+    return run(callbacks, handler, options, [input](xmlParserCtxtPtr ctxt, const int libxmlOptions) {
+        if (input.size() <= maxMemoryInput)
+            return xmlCtxtReadMemory(ctxt, input.data(), static_cast<int>(input.size()), nullptr, nullptr,
+                                     libxmlOptions);
+        auto context = MemoryInput{input};
+        return xmlCtxtReadIO(ctxt, readFromMemory, nullptr, &context, nullptr, nullptr, libxmlOptions);
+    });
+}
+
+std::expected<void, RuntimeError> saxParseFile(const std::filesystem::path &path, const SaxCallbacks &callbacks,
+                                               void *handler, const ParserOptions options) noexcept
+{
+    if (!std::filesystem::exists(path))
+        return std::unexpected{RuntimeError{"Document don't exist."}};
+
+    const auto fileName = path.string();
+    return run(callbacks, handler, options, [&fileName](xmlParserCtxtPtr ctxt, const int libxmlOptions) {
+        return xmlCtxtReadFile(ctxt, fileName.c_str(), nullptr, libxmlOptions);
+    });
+}
+} // namespace cpplibxml2::detail
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "outputSink.hpp"
+
+#include <exception>
+
+namespace cpplibxml2::detail
+{
+/**
+ * Context of an xmlOutputBuffer that writes into an OutputSink, see writeToSink().
+ */
+struct SinkContext
+{
+    OutputSink *sink;
+    std::exception_ptr exception;
+};
+
+/**
+ * xmlOutputWriteCallback forwarding to SinkContext::sink. Exceptions must not cross the libxml2 frames, so they are
+ * stored in the context for the caller to rethrow.
+ */
+int writeToSink(void *context, const char *buffer, int len);
+} // namespace cpplibxml2::detail
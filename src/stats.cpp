@@ -0,0 +1,196 @@
+#include "stats.hpp"
+
+#include "instrumentation.hpp"
+
+#ifdef CPPLIBXML2_ENABLE_STATS
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <vector>
+
+namespace cpplibxml2
+{
+namespace
+{
+constexpr auto counterCount = static_cast<std::size_t>(detail::Counter::Count);
+constexpr auto timerCount = static_cast<std::size_t>(detail::Timer::Count);
+
+/**
+ * Plain sums, for the counters of exited threads and the reset baseline.
+ */
+struct Totals
+{
+    std::array<std::uint64_t, counterCount> counters{};
+    std::array<DurationHistogram, timerCount> timers{};
+
+    void subtract(const Totals &other) noexcept
+    {
+        for (std::size_t i = 0; i < counterCount; ++i)
+            this->counters[i] -= other.counters[i];
+        for (std::size_t t = 0; t < timerCount; ++t)
+        {
+            auto &timer = this->timers[t];
+            const auto &otherTimer = other.timers[t];
+            for (std::size_t b = 0; b < DurationHistogram::bucketCount; ++b)
+                timer.buckets[b] -= otherTimer.buckets[b];
+            timer.count -= otherTimer.count;
+            timer.totalNanoseconds -= otherTimer.totalNanoseconds;
+        }
+    }
+};
+
+/**
+ * Counters of one thread. Only the owning thread writes them, so an increment is a relaxed load and store instead of
+ * a locked read-modify-write; the atomics only make the concurrent reads in statsSnapshot() well defined.
+ */
+struct ThreadStats
+{
+    struct Histogram
+    {
+        std::array<std::atomic<std::uint64_t>, DurationHistogram::bucketCount> buckets{};
+        std::atomic<std::uint64_t> count{0};
+        std::atomic<std::uint64_t> totalNanoseconds{0};
+    };
+
+    std::array<std::atomic<std::uint64_t>, counterCount> counters{};
+    std::array<Histogram, timerCount> timers{};
+
+    ThreadStats();
+
+    ThreadStats(const ThreadStats &) = delete;
+
+    ThreadStats &operator=(const ThreadStats &) = delete;
+
+    ~ThreadStats();
+
+    void addTo(Totals &totals) const noexcept
+    {
+        for (std::size_t i = 0; i < counterCount; ++i)
+            totals.counters[i] += this->counters[i].load(std::memory_order_relaxed);
+        for (std::size_t t = 0; t < timerCount; ++t)
+        {
+            const auto &timer = this->timers[t];
+            auto &total = totals.timers[t];
+            for (std::size_t b = 0; b < DurationHistogram::bucketCount; ++b)
+                total.buckets[b] += timer.buckets[b].load(std::memory_order_relaxed);
+            total.count += timer.count.load(std::memory_order_relaxed);
+            total.totalNanoseconds += timer.totalNanoseconds.load(std::memory_order_relaxed);
+        }
+    }
+};
+
+void increment(std::atomic<std::uint64_t> &cell, const std::uint64_t amount) noexcept
+{
+    cell.store(cell.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<const ThreadStats *> threads;
+    Totals exited;
+    Totals baseline;
+
+    [[nodiscard]] Totals collect() const noexcept
+    {
+        auto totals = this->exited;
+        for (const auto thread : this->threads)
+            thread->addTo(totals);
+        return totals;
+    }
+};
+
+// Constructed before the first ThreadStats, so it outlives all of them.
+Registry &registry() noexcept
+{
+    static Registry instance;
+    return instance;
+}
+
+ThreadStats::ThreadStats()
+{
+    auto &global = registry();
+    const std::scoped_lock lock{global.mutex};
+    global.threads.push_back(this);
+}
+
+ThreadStats::~ThreadStats()
+{
+    auto &global = registry();
+    const std::scoped_lock lock{global.mutex};
+    this->addTo(global.exited);
+    std::erase(global.threads, this);
+}
+
+ThreadStats &local() noexcept
+{
+    thread_local ThreadStats stats;
+    return stats;
+}
+} // namespace
+
+void detail::addToCounter(const Counter counter, const std::uint64_t amount) noexcept
+{
+    increment(local().counters[static_cast<std::size_t>(counter)], amount);
+}
+
+void detail::recordDuration(const Timer timer, const std::uint64_t nanoseconds) noexcept
+{
+    auto &histogram = local().timers[static_cast<std::size_t>(timer)];
+    // Bucket b counts durations in [2^b, 2^(b+1)) ns.
+    const std::size_t width = std::bit_width(nanoseconds);
+    const auto bucket = std::min(width < 2 ? 0 : width - 1, DurationHistogram::bucketCount - 1);
+    increment(histogram.buckets[bucket], 1);
+    increment(histogram.count, 1);
+    increment(histogram.totalNanoseconds, nanoseconds);
+}
+
+Stats statsSnapshot() noexcept
+{
+    auto &global = registry();
+    const std::scoped_lock lock{global.mutex};
+    auto totals = global.collect();
+    totals.subtract(global.baseline);
+
+    using detail::Counter;
+    const auto counter = [&totals](const Counter which) { return totals.counters[static_cast<std::size_t>(which)]; };
+    Stats stats;
+    stats.parseCalls = counter(Counter::ParseCalls);
+    stats.parseFailures = counter(Counter::ParseFailures);
+    stats.bytesParsed = counter(Counter::BytesParsed);
+    stats.nodesVisited = counter(Counter::NodesVisited);
+    stats.nodeHandles = counter(Counter::NodeHandles);
+    stats.valueCopies = counter(Counter::ValueCopies);
+    stats.valueBytesCopied = counter(Counter::ValueBytesCopied);
+    stats.serializeCalls = counter(Counter::SerializeCalls);
+    stats.serializedBytes = counter(Counter::SerializedBytes);
+    stats.parseTime = totals.timers[static_cast<std::size_t>(detail::Timer::Parse)];
+    stats.serializeTime = totals.timers[static_cast<std::size_t>(detail::Timer::Serialize)];
+    return stats;
+}
+
+void resetStats() noexcept
+{
+    auto &global = registry();
+    const std::scoped_lock lock{global.mutex};
+    global.baseline = global.collect();
+}
+} // namespace cpplibxml2
+
+#else
+
+namespace cpplibxml2
+{
+Stats statsSnapshot() noexcept
+{
+    return {};
+}
+
+void resetStats() noexcept
+{
+}
+} // namespace cpplibxml2
+
+#endif
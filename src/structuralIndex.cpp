@@ -0,0 +1,385 @@
+#include "structuralIndex.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CPPLIBXML2_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__)
+#define CPPLIBXML2_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CPPLIBXML2_TARGET_AVX2
+#endif
+
+namespace cpplibxml2
+{
+namespace
+{
+constexpr auto npos = std::string_view::npos;
+
+/**
+ * @return Whether `c` ends an element name in a tag
+ */
+constexpr bool endsName(const char c) noexcept
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '/' || c == '>';
+}
+
+/**
+ * Appends `base + i` for every set bit i of `mask`, in ascending order.
+ */
+void appendBits(std::vector<std::size_t> &offsets, const std::size_t base, std::uint64_t mask)
+{
+    // One resize per block instead of a capacity check per offset.
+    const auto count = offsets.size();
+    offsets.resize(count + static_cast<std::size_t>(std::popcount(mask)));
+    auto *out = offsets.data() + count;
+    while (mask != 0)
+    {
+        *out++ = base + static_cast<std::size_t>(std::countr_zero(mask));
+        mask &= mask - 1;
+    }
+}
+
+void scanScalar(const std::string_view input, const std::size_t from, std::vector<std::size_t> &offsets)
+{
+    for (auto i = from; i < input.size(); ++i)
+    {
+        switch (input[i])
+        {
+        case '<':
+        case '>':
+        case '"':
+        case '\'':
+            offsets.push_back(i);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+#ifdef CPPLIBXML2_X86
+void scanSse2(const std::string_view input, std::vector<std::size_t> &offsets)
+{
+    const auto lt = _mm_set1_epi8('<');
+    const auto gt = _mm_set1_epi8('>');
+    const auto quot = _mm_set1_epi8('"');
+    const auto apos = _mm_set1_epi8('\'');
+    std::size_t i = 0;
+    for (; i + 16 <= input.size(); i += 16)
+    {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input.data() + i));
+        const auto hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, lt), _mm_cmpeq_epi8(block, gt)),
+                                       _mm_or_si128(_mm_cmpeq_epi8(block, quot), _mm_cmpeq_epi8(block, apos)));
+        appendBits(offsets, i, static_cast<std::uint32_t>(_mm_movemask_epi8(hits)));
+    }
+    scanScalar(input, i, offsets);
+}
+
+CPPLIBXML2_TARGET_AVX2 std::uint64_t maskAvx2(const char *data)
+{
+    const auto lt = _mm256_set1_epi8('<');
+    const auto gt = _mm256_set1_epi8('>');
+    const auto quot = _mm256_set1_epi8('"');
+    const auto apos = _mm256_set1_epi8('\'');
+    const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+    const auto hits = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, lt), _mm256_cmpeq_epi8(block, gt)),
+                                      _mm256_or_si256(_mm256_cmpeq_epi8(block, quot), _mm256_cmpeq_epi8(block, apos)));
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(hits));
+}
+
+CPPLIBXML2_TARGET_AVX2 void scanAvx2(const std::string_view input, std::vector<std::size_t> &offsets)
+{
+    std::size_t i = 0;
+    for (; i + 64 <= input.size(); i += 64)
+        appendBits(offsets, i, maskAvx2(input.data() + i) | maskAvx2(input.data() + i + 32) << 32);
+    scanScalar(input, i, offsets);
+}
+
+SimdLevel detectLevel() noexcept
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return SimdLevel::Sse2;
+    __cpuid(info, 1);
+    const bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && (info[1] & (1 << 5)) != 0 ? SimdLevel::Avx2 : SimdLevel::Sse2;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? SimdLevel::Avx2 : SimdLevel::Sse2;
+#endif
+}
+#else
+SimdLevel detectLevel() noexcept
+{
+    return SimdLevel::Scalar;
+}
+#endif
+
+std::vector<std::size_t> scan(const std::string_view input, const SimdLevel level)
+{
+    std::vector<std::size_t> offsets;
+    // Markup rarely has more structural characters than that; pages of the reserve are only touched when used.
+    offsets.reserve(input.size() / 4);
+    switch (level)
+    {
+#ifdef CPPLIBXML2_X86
+    case SimdLevel::Avx2:
+        scanAvx2(input, offsets);
+        break;
+    case SimdLevel::Sse2:
+        scanSse2(input, offsets);
+        break;
+#endif
+    default:
+        scanScalar(input, 0, offsets);
+        break;
+    }
+    return offsets;
+}
+
+/**
+ * @return The offset after the '>' that closes the DOCTYPE at `at`, past its internal subset, or npos
+ */
+std::size_t skipDoctype(const std::string_view input, const std::size_t at)
+{
+    std::size_t brackets = 0;
+    char quote = 0;
+    for (auto i = at + 2; i < input.size(); ++i)
+    {
+        const auto c = input[i];
+        if (quote != 0)
+        {
+            if (c == quote)
+                quote = 0;
+            continue;
+        }
+        switch (c)
+        {
+        case '"':
+        case '\'':
+            quote = c;
+            break;
+        case '[':
+            ++brackets;
+            break;
+        case ']':
+            brackets -= brackets > 0 ? 1 : 0;
+            break;
+        case '<':
+            // Comments and processing instructions in the internal subset may contain quotes.
+            if (const auto markup = input.substr(i); markup.starts_with("<!--") || markup.starts_with("<?"))
+            {
+                const auto terminator = markup[1] == '!' ? std::string_view{"-->"} : std::string_view{"?>"};
+                i = input.find(terminator, i + 2);
+                if (i == npos)
+                    return npos;
+                i += terminator.size() - 1;
+            }
+            break;
+        case '>':
+            if (brackets == 0)
+                return i + 1;
+            break;
+        default:
+            break;
+        }
+    }
+    return npos;
+}
+
+/**
+ * Second pass: walks the structural characters and matches tags.
+ */
+class TagMatcher
+{
+    std::string_view input;
+    std::span<const std::size_t> offsets;
+    std::size_t next = 0;
+
+    /**
+     * Moves past the structural characters before `offset`.
+     */
+    void skipTo(const std::size_t offset) noexcept
+    {
+        while (this->next < this->offsets.size() && this->offsets[this->next] < offset)
+            ++this->next;
+    }
+
+    /**
+     * @return The offset of the next structural character `c`, or npos
+     */
+    std::size_t find(const char c) noexcept
+    {
+        while (this->next < this->offsets.size())
+        {
+            const auto offset = this->offsets[this->next++];
+            if (this->input[offset] == c)
+                return offset;
+        }
+        return npos;
+    }
+
+    /**
+     * Skips to the end of markup that ends with `terminator`, searching from `from`.
+     */
+    bool skipPast(const std::string_view terminator, const std::size_t from) noexcept
+    {
+        const auto end = this->input.find(terminator, from);
+        if (end == npos)
+            return false;
+        this->skipTo(end + terminator.size());
+        return true;
+    }
+
+    /**
+     * @return The name starting at `offset` of a tag that ends at `close`
+     */
+    [[nodiscard]] std::string_view nameAt(const std::size_t offset, const std::size_t close) const noexcept
+    {
+        auto end = offset;
+        while (end < close && !endsName(this->input[end]))
+            ++end;
+        return this->input.substr(offset, end - offset);
+    }
+
+  public:
+    TagMatcher(const std::string_view source, const std::span<const std::size_t> structurals) noexcept
+        : input(source), offsets(structurals)
+    {
+    }
+
+    std::expected<std::vector<StructuralIndex::Element>, RuntimeError> match()
+    {
+        const auto unterminated = [] { return std::unexpected{RuntimeError{"Unterminated markup."}}; };
+        std::vector<StructuralIndex::Element> elements;
+        // Every element takes at least two structural characters, usually four or more.
+        elements.reserve(this->offsets.size() / 4);
+        std::vector<std::size_t> open;
+        while (this->next < this->offsets.size())
+        {
+            const auto at = this->offsets[this->next++];
+            // '>' and quotes outside of tags are text.
+            if (this->input[at] != '<')
+                continue;
+            if (at + 1 == this->input.size())
+                return unterminated();
+
+            switch (this->input[at + 1])
+            {
+            case '!':
+                if (const auto markup = this->input.substr(at); markup.starts_with("<!--"))
+                {
+                    if (!this->skipPast("-->", at + 4))
+                        return unterminated();
+                }
+                else if (markup.starts_with("<![CDATA["))
+                {
+                    if (!this->skipPast("]]>", at + 9))
+                        return unterminated();
+                }
+                else
+                {
+                    const auto end = skipDoctype(this->input, at);
+                    if (end == npos)
+                        return unterminated();
+                    this->skipTo(end);
+                }
+                break;
+            case '?':
+                if (!this->skipPast("?>", at + 2))
+                    return unterminated();
+                break;
+            case '/': {
+                const auto close = this->find('>');
+                if (close == npos)
+                    return unterminated();
+                if (open.empty())
+                    return std::unexpected{RuntimeError{"Mismatched end tag."}};
+                auto &element = elements[open.back()];
+                const auto nameEndsAt = at + 2 + element.name.size();
+                if (nameEndsAt > close || this->input.substr(at + 2, element.name.size()) != element.name ||
+                    !endsName(this->input[nameEndsAt]))
+                    return std::unexpected{RuntimeError{"Mismatched end tag."}};
+                element.end = close + 1;
+                open.pop_back();
+                break;
+            }
+            default: {
+                auto close = npos;
+                while (close == npos && this->next < this->offsets.size())
+                {
+                    const auto offset = this->offsets[this->next++];
+                    const auto c = this->input[offset];
+                    if (c == '>')
+                        close = offset;
+                    else if (c == '<' || this->find(c) == npos)
+                        return unterminated();
+                }
+                if (close == npos)
+                    return unterminated();
+                elements.push_back({at, npos, open.size(), this->nameAt(at + 1, close)});
+                if (this->input[close - 1] == '/')
+                    elements.back().end = close + 1;
+                else
+                    open.push_back(elements.size() - 1);
+                break;
+            }
+            }
+        }
+        if (!open.empty())
+            return unterminated();
+        return elements;
+    }
+};
+} // namespace
+
+SimdLevel StructuralIndex::supportedLevel() noexcept
+{
+    static const auto level = detectLevel();
+    return level;
+}
+
+std::expected<StructuralIndex, RuntimeError> StructuralIndex::build(const std::string_view input)
+{
+    return build(input, supportedLevel());
+}
+
+std::expected<StructuralIndex, RuntimeError> StructuralIndex::build(const std::string_view input, SimdLevel level)
+{
+    level = std::min(level, supportedLevel());
+    StructuralIndex index;
+    index.usedLevel = level;
+    index.structuralOffsets = scan(input, level);
+    auto elements = TagMatcher{input, index.structuralOffsets}.match();
+    if (!elements)
+        return std::unexpected{elements.error()};
+    index.elementList = std::move(elements.value());
+    return index;
+}
+
+std::vector<StructuralIndex::Element> StructuralIndex::records(const std::string_view name) const
+{
+    std::vector<Element> result;
+    std::size_t covered = 0;
+    for (const auto &element : this->elementList)
+    {
+        if (element.begin < covered || element.name != name)
+            continue;
+        result.push_back(element);
+        covered = element.end;
+    }
+    return result;
+}
+} // namespace cpplibxml2
@@ -0,0 +1,276 @@
+#include "writer.hpp"
+
+#include "helper.hpp"
+#include "sinkIo.hpp"
+
+#include <libxml/xmlwriter.h>
+
+#include <array>
+#include <optional>
+#include <utility>
+
+namespace cpplibxml2
+{
+namespace
+{
+struct xmlTextWriterDeleter
+{
+    void operator()(xmlTextWriter *writer) const
+    {
+        xmlFreeTextWriter(writer);
+    }
+};
+
+using xmlTextWriterPtr_t = std::unique_ptr<xmlTextWriter, xmlTextWriterDeleter>;
+} // namespace
+
+struct Writer::Impl
+{
+    // Declared before the writer, which still flushes into it when it is destroyed.
+    std::optional<OutputSink> sink;
+    detail::SinkContext context{nullptr, nullptr};
+    xmlTextWriterPtr_t writer;
+    bool started = false;
+    // Open elements, for closing them in finish() when no document was started.
+    std::size_t depth = 0;
+    // xmlTextWriter takes NUL-terminated strings; the copies reuse these buffers.
+    std::array<std::string, 4> scratch;
+
+    ~Impl()
+    {
+        try
+        {
+            this->writer.reset();
+            if (this->sink)
+                (void)this->sink->flush();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    const xmlChar *terminated(const std::size_t slot, const std::string_view text)
+    {
+        this->scratch[slot].assign(text);
+        return reinterpret_cast<const xmlChar *>(this->scratch[slot].c_str());
+    }
+
+    const xmlChar *terminatedOrNull(const std::size_t slot, const std::string_view text)
+    {
+        return text.empty() ? nullptr : this->terminated(slot, text);
+    }
+
+    std::expected<void, RuntimeError> check(const int rc)
+    {
+        if (auto exception = std::exchange(this->context.exception, nullptr))
+            std::rethrow_exception(exception);
+        if (rc < 0)
+            return std::unexpected{RuntimeError{"Failed to write XML."}};
+        return {};
+    }
+};
+
+Writer::Writer() : impl(std::make_unique<Impl>())
+{
+}
+
+Writer::Writer(Writer &&) noexcept = default;
+
+Writer::~Writer() = default;
+
+Writer &Writer::operator=(Writer &&) noexcept = default;
+
+namespace
+{
+std::expected<void, RuntimeError> configure(xmlTextWriter *writer, const bool addWhiteSpaces) noexcept
+{
+    // Two spaces, like Doc::dump and Doc::serialize.
+    if (addWhiteSpaces && (xmlTextWriterSetIndent(writer, 1) != 0 ||
+                           xmlTextWriterSetIndentString(writer, reinterpret_cast<const xmlChar *>("  ")) != 0))
+        return std::unexpected{RuntimeError{"Failed to configure writer."}};
+    return {};
+}
+} // namespace
+
+std::expected<Writer, RuntimeError> Writer::toFile(const std::filesystem::path &path,
+                                                   const bool addWhiteSpaces) noexcept
+{
+    initLibrary();
+
+    auto result = Writer{};
+    result.impl->writer = xmlTextWriterPtr_t{xmlNewTextWriterFilename(path.string().c_str(), 0)};
+    if (!result.impl->writer)
+        return std::unexpected{RuntimeError{"Failed to open file for writing."}};
+    return configure(result.impl->writer.get(), addWhiteSpaces).transform([&result] { return std::move(result); });
+}
+
+std::expected<Writer, RuntimeError> Writer::toSink(OutputSink sink, const bool addWhiteSpaces) noexcept
+{
+    initLibrary();
+
+    auto result = Writer{};
+    auto &impl = *result.impl;
+    impl.sink.emplace(std::move(sink));
+    impl.context.sink = &*impl.sink;
+
+    const auto out = xmlOutputBufferCreateIO(detail::writeToSink, nullptr, &impl.context, nullptr);
+    if (!out)
+        return std::unexpected{RuntimeError{"Failed to create output buffer."}};
+    // The writer owns the output buffer from here on.
+    impl.writer = xmlTextWriterPtr_t{xmlNewTextWriter(out)};
+    if (!impl.writer)
+    {
+        xmlOutputBufferClose(out);
+        return std::unexpected{RuntimeError{"Failed to create writer."}};
+    }
+    return configure(impl.writer.get(), addWhiteSpaces).transform([&result] { return std::move(result); });
+}
+
+std::expected<void, RuntimeError> Writer::startDocument(const Format format)
+{
+    if (!this->impl->writer)
+        return std::unexpected{RuntimeError{"Writer is closed."}};
+    const auto encoding = to_string(format);
+    const auto rc = xmlTextWriterStartDocument(this->impl->writer.get(), nullptr, encoding.c_str(), nullptr);
+    this->impl->started = this->impl->started || rc >= 0;
+    return this->impl->check(rc);
+}
+
+std::expected<void, RuntimeError> Writer::endDocument()
+{
+    if (!this->impl->writer)
+        return std::unexpected{RuntimeError{"Writer is closed."}};
+    auto &state = *this->impl;
+    state.started = false;
+    state.depth = 0;
+    return state.check(xmlTextWriterEndDocument(state.writer.get()));
+}
+
+std::expected<void, RuntimeError> Writer::startElement(const std::string_view name)
+{
+    if (!this->impl->writer)
+        return std::unexpected{RuntimeError{"Writer is closed."}};
+    auto &state = *this->impl;
+    return state.check(xmlTextWriterStartElement(state.writer.get(), state.terminated(0, name))).transform([&state] {
+        ++state.depth;
+    });
+}
+
+std::expected<void, RuntimeError> Writer::startElement(const std::string_view prefix, const std::string_view name,
+                                                       const std::string_view nsUri)
+{
+    if (!this->impl->writer)
+        return std::unexpected{RuntimeError{"Writer is closed."}};
+    auto &state = *this->impl;
+    return state
+        .check(xmlTextWriterStartElementNS(state.writer.get(), state.terminatedOrNull(0, prefix),
+                                           state.terminated(1, name), state.terminatedOrNull(2, nsUri)))
+        .transform([&state] { ++state.depth; });
+}
+
+std::expected<void, RuntimeError> Writer::endElement()
+{
+    if (!this->impl->writer)
+        return std::unexpected{RuntimeError{"Writer is closed."}};
+    auto &state = *this->impl;
+    return state.check(xmlTextWriterEndElement(state.writer.get())).transform([&state] { --state.depth; });
+}
+
+std::expected<void, RuntimeError> Writer::element(const std::string_view name, const std::string_view text)
+{
+    if (!this->impl->writer)
+        return std::unexpected{RuntimeError{"Writer is closed."}};
+    auto &state = *this->impl;
+    return state.check(
+        xmlTextWriterWriteElement(state.writer.get(), state.terminated(0, name), state.terminated(1, text)));
+}
+
+std::expected<void, RuntimeError> Writer::attribute(const std::string_view name, const std::string_view value)
+{
+    if (!this->impl->writer)
+        return std::unexpected{RuntimeError{"Writer is closed."}};
+    auto &state = *this->impl;
+    return state.check(
+        xmlTextWriterWriteAttribute(state.writer.get(), state.terminated(0, name), state.terminated(1, value)));
+}
+
+std::expected<void, RuntimeError> Writer::attribute(const std::string_view prefix, const std::string_view name,
+                                                    const std::string_view nsUri, const std::string_view value)
+{
+    if (!this->impl->writer)
+        return std::unexpected{RuntimeError{"Writer is closed."}};
+    auto &state = *this->impl;
+    return state.check(xmlTextWriterWriteAttributeNS(state.writer.get(), state.terminatedOrNull(0, prefix),
+                                                    state.terminated(1, name), state.terminatedOrNull(2, nsUri),
+                                                    state.terminated(3, value)));
+}
+
+std::expected<void, RuntimeError> Writer::addNamespace(const std::string_view prefix, const std::string_view uri)
+{
+    if (!this->impl->writer)
+        return std::unexpected{RuntimeError{"Writer is closed."}};
+    auto &state = *this->impl;
+    auto &name = state.scratch[0];
+    name.assign("xmlns");
+    if (!prefix.empty())
+        name.append(":").append(prefix);
+    return state.check(xmlTextWriterWriteAttribute(state.writer.get(), reinterpret_cast<const xmlChar *>(name.c_str()),
+                                                  state.terminated(1, uri)));
+}
+
+std::expected<void, RuntimeError> Writer::text(const std::string_view text)
+{
+    if (!this->impl->writer)
+        return std::unexpected{RuntimeError{"Writer is closed."}};
+    auto &state = *this->impl;
+    return state.check(xmlTextWriterWriteString(state.writer.get(), state.terminated(0, text)));
+}
+
+std::expected<void, RuntimeError> Writer::cdata(const std::string_view text)
+{
+    if (!this->impl->writer)
+        return std::unexpected{RuntimeError{"Writer is closed."}};
+    auto &state = *this->impl;
+    return state.check(xmlTextWriterWriteCDATA(state.writer.get(), state.terminated(0, text)));
+}
+
+std::expected<void, RuntimeError> Writer::comment(const std::string_view text)
+{
+    if (!this->impl->writer)
+        return std::unexpected{RuntimeError{"Writer is closed."}};
+    auto &state = *this->impl;
+    return state.check(xmlTextWriterWriteComment(state.writer.get(), state.terminated(0, text)));
+}
+
+std::expected<void, RuntimeError> Writer::flush()
+{
+    if (!this->impl->writer)
+        return std::unexpected{RuntimeError{"Writer is closed."}};
+    auto &state = *this->impl;
+    if (auto flushed = state.check(xmlTextWriterFlush(state.writer.get())); !flushed)
+        return flushed;
+    if (state.sink && !state.sink->flush())
+        return std::unexpected{RuntimeError{"Failed to write XML."}};
+    return {};
+}
+
+std::expected<void, RuntimeError> Writer::finish()
+{
+    if (!this->impl->writer)
+        return std::unexpected{RuntimeError{"Writer is closed."}};
+    auto &state = *this->impl;
+    if (state.started)
+    {
+        if (auto ended = this->endDocument(); !ended)
+            return ended;
+    }
+    while (state.depth > 0)
+    {
+        if (auto ended = this->endElement(); !ended)
+            return ended;
+    }
+    auto flushed = this->flush();
+    state.writer.reset();
+    return flushed;
+}
+} // namespace cpplibxml2
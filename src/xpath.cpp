@@ -0,0 +1,324 @@
+#include "xpath.hpp"
+
+#include "access.hpp"
+#include "helper.hpp"
+
+#include <libxml/xpath.h>
+#include <libxml/xpathInternals.h>
+
+#include <algorithm>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace cpplibxml2
+{
+namespace
+{
+struct xmlXPathCompExprDeleter
+{
+    void operator()(xmlXPathCompExpr *expression) const
+    {
+        xmlXPathFreeCompExpr(expression);
+    }
+};
+
+struct xmlXPathObjectDeleter
+{
+    void operator()(xmlXPathObject *object) const
+    {
+        xmlXPathFreeObject(object);
+    }
+};
+
+struct xmlXPathContextDeleter
+{
+    void operator()(xmlXPathContext *context) const
+    {
+        xmlXPathFreeContext(context);
+    }
+};
+
+using xmlXPathCompExprPtr_t = std::unique_ptr<xmlXPathCompExpr, xmlXPathCompExprDeleter>;
+using xmlXPathObjectPtr_t = std::unique_ptr<xmlXPathObject, xmlXPathObjectDeleter>;
+using xmlXPathContextPtr_t = std::unique_ptr<xmlXPathContext, xmlXPathContextDeleter>;
+
+// Errors are reported through the returned std::expected, keep libxml2 from printing them as well.
+void ignoreError(void *, const xmlError *)
+{
+}
+
+xmlXPathContextPtr_t newContext(xmlDocPtr doc) noexcept
+{
+    auto context = xmlXPathContextPtr_t{xmlXPathNewContext(doc)};
+    if (context)
+        xmlXPathSetErrorHandler(context.get(), ignoreError, nullptr);
+    return context;
+}
+} // namespace
+
+struct XPathExpression::Impl
+{
+    xmlXPathCompExprPtr_t expression;
+};
+
+struct XPathResult::Impl
+{
+    xmlXPathObjectPtr_t object;
+    // The node-set without its namespace entries, if it has any; empty and unused otherwise.
+    std::vector<xmlNodePtr> nodes;
+    bool filtered = false;
+
+    [[nodiscard]] std::span<xmlNodePtr const> view() const noexcept
+    {
+        if (this->filtered)
+            return this->nodes;
+        const auto set = this->object->nodesetval;
+        if (!set || !set->nodeTab)
+            return {};
+        return {set->nodeTab, static_cast<std::size_t>(set->nodeNr)};
+    }
+
+    /**
+     * Namespace entries are xmlNs copies, not nodes: leave them out of the node-set view.
+     */
+    void dropNamespaces()
+    {
+        const auto all = this->view();
+        if (std::ranges::none_of(all, [](const xmlNodePtr node) { return node->type == XML_NAMESPACE_DECL; }))
+            return;
+        std::ranges::copy_if(all, std::back_inserter(this->nodes),
+                             [](const xmlNodePtr node) { return node->type != XML_NAMESPACE_DECL; });
+        this->filtered = true;
+    }
+};
+
+struct XPathContext::Impl
+{
+    xmlXPathContextPtr_t context;
+};
+
+XPathExpression::XPathExpression() : impl(std::make_unique<Impl>())
+{
+}
+
+XPathExpression::XPathExpression(XPathExpression &&) noexcept = default;
+
+XPathExpression::~XPathExpression() = default;
+
+XPathExpression &XPathExpression::operator=(XPathExpression &&) noexcept = default;
+
+std::expected<XPathExpression, RuntimeError> XPathExpression::compile(const std::string_view expression) noexcept
+{
+    initLibrary();
+
+    // Compiling through a context routes syntax errors to its (silent) handler.
+    const auto context = newContext(nullptr);
+    if (!context)
+        return std::unexpected{RuntimeError{"Failed to create XPath context."}};
+
+    auto compiled = xmlXPathCompExprPtr_t{
+        xmlXPathCtxtCompile(context.get(), reinterpret_cast<const xmlChar *>(std::string{expression}.c_str()))};
+    if (!compiled)
+        return std::unexpected{RuntimeError{"Invalid XPath expression."}};
+
+    auto result = XPathExpression{};
+    result.impl->expression = std::move(compiled);
+    return result;
+}
+
+XPathResult::XPathResult() : impl(std::make_unique<Impl>())
+{
+}
+
+XPathResult::XPathResult(XPathResult &&) noexcept = default;
+
+XPathResult::~XPathResult() = default;
+
+XPathResult &XPathResult::operator=(XPathResult &&) noexcept = default;
+
+XPathResultType XPathResult::type() const noexcept
+{
+    return static_cast<XPathResultType>(this->impl->object->type);
+}
+
+XPathNodeIterator XPathResult::begin() const noexcept
+{
+    return XPathNodeIterator{this->impl->view().data()};
+}
+
+XPathNodeIterator XPathResult::end() const noexcept
+{
+    const auto nodes = this->impl->view();
+    return XPathNodeIterator{nodes.data() + nodes.size()};
+}
+
+std::size_t XPathResult::size() const noexcept
+{
+    return this->impl->view().size();
+}
+
+bool XPathResult::empty() const noexcept
+{
+    return this->size() == 0;
+}
+
+bool XPathResult::boolean() const noexcept
+{
+    return xmlXPathCastToBoolean(this->impl->object.get()) != 0;
+}
+
+double XPathResult::number() const noexcept
+{
+    return xmlXPathCastToNumber(this->impl->object.get());
+}
+
+std::string XPathResult::string() const
+{
+    const auto value = std::unique_ptr<xmlChar, decltype([](xmlChar *in) { xmlFree(in); })>{
+        xmlXPathCastToString(this->impl->object.get())};
+    return std::string{toStringView(value.get())};
+}
+
+XPathContext::XPathContext() : impl(std::make_unique<Impl>())
+{
+}
+
+XPathContext::XPathContext(XPathContext &&) noexcept = default;
+
+XPathContext::~XPathContext() = default;
+
+XPathContext &XPathContext::operator=(XPathContext &&) noexcept = default;
+
+std::expected<XPathContext, RuntimeError> XPathContext::create(const Doc &doc) noexcept
+{
+    initLibrary();
+
+    const auto raw = detail::Access::raw(doc);
+    if (!raw)
+        return std::unexpected{RuntimeError{"Document is null."}};
+
+    auto context = newContext(raw);
+    if (!context)
+        return std::unexpected{RuntimeError{"Failed to create XPath context."}};
+
+    auto result = XPathContext{};
+    result.impl->context = std::move(context);
+    return result;
+}
+
+void XPathContext::setDocument(const Doc &doc) noexcept
+{
+    this->impl->context->doc = detail::Access::raw(doc);
+    this->impl->context->node = nullptr;
+}
+
+std::expected<void, RuntimeError> XPathContext::registerNamespace(const std::string_view prefix,
+                                                                  const std::string_view uri) noexcept
+{
+    if (prefix.empty())
+        return std::unexpected{RuntimeError{"Namespace prefix is empty."}};
+    if (xmlXPathRegisterNs(this->impl->context.get(), reinterpret_cast<const xmlChar *>(std::string{prefix}.c_str()),
+                           reinterpret_cast<const xmlChar *>(std::string{uri}.c_str())) != 0)
+        return std::unexpected{RuntimeError{"Failed to register namespace."}};
+    return {};
+}
+
+std::expected<void, RuntimeError> XPathContext::registerNamespaces(const Node node) noexcept
+{
+    const auto context = this->impl->context.get();
+    for (auto current = detail::Access::raw(node); current; current = current->parent)
+    {
+        if (current->type != XML_ELEMENT_NODE)
+            continue;
+        for (auto ns = current->nsDef; ns; ns = ns->next)
+        {
+            // Already bound by a nearer declaration.
+            if (!ns->prefix || xmlXPathNsLookup(context, ns->prefix))
+                continue;
+            if (xmlXPathRegisterNs(context, ns->prefix, ns->href) != 0)
+                return std::unexpected{RuntimeError{"Failed to register namespace."}};
+        }
+    }
+    return {};
+}
+
+std::expected<XPathResult, RuntimeError> XPathContext::evaluate(const XPathExpression &expression) noexcept
+{
+    const auto doc = this->impl->context->doc;
+    if (!doc)
+        return std::unexpected{RuntimeError{"Document is null."}};
+    return this->evaluate(expression, detail::Access::makeNode(reinterpret_cast<xmlNodePtr>(doc)));
+}
+
+std::expected<XPathResult, RuntimeError> XPathContext::evaluate(const XPathExpression &expression,
+                                                                const Node context) noexcept
+{
+    const auto node = detail::Access::raw(context);
+    if (!node)
+        return std::unexpected{RuntimeError{"Node is null."}};
+    if (node->doc != this->impl->context->doc)
+        return std::unexpected{RuntimeError{"Node belongs to another document."}};
+    this->impl->context->node = node;
+
+    auto object =
+        xmlXPathObjectPtr_t{xmlXPathCompiledEval(expression.impl->expression.get(), this->impl->context.get())};
+    if (!object)
+        return std::unexpected{RuntimeError{"XPath evaluation failed."}};
+
+    auto result = XPathResult{};
+    result.impl->object = std::move(object);
+    result.impl->dropNamespaces();
+    return result;
+}
+
+std::expected<XPathResult, RuntimeError> XPathContext::evaluate(const std::string_view expression) noexcept
+{
+    return XPathExpression::compile(expression).and_then(
+        [this](const XPathExpression &compiled) { return this->evaluate(compiled); });
+}
+
+std::expected<XPathResult, RuntimeError> XPathContext::evaluate(const std::string_view expression,
+                                                                const Node context) noexcept
+{
+    return XPathExpression::compile(expression).and_then(
+        [this, context](const XPathExpression &compiled) { return this->evaluate(compiled, context); });
+}
+
+std::expected<XPathResult, RuntimeError> Doc::query(const std::string_view expression) const
+{
+    if (!this->impl->doc)
+        return std::unexpected{RuntimeError{"Document is null."}};
+    return this->query(expression, detail::Access::makeNode(reinterpret_cast<xmlNodePtr>(this->impl->doc.get())));
+}
+
+std::expected<XPathResult, RuntimeError> Doc::query(const std::string_view expression, const Node context) const
+{
+    if (!this->impl->doc)
+        return std::unexpected{RuntimeError{"Document is null."}};
+
+    auto &cache = this->impl->xpath;
+    if (!cache)
+        cache = std::make_unique<detail::XPathCache>();
+
+    if (!cache->context)
+    {
+        auto created = XPathContext::create(*this);
+        if (!created)
+            return std::unexpected{created.error()};
+        if (const auto root = this->root())
+            (void)created.value().registerNamespaces(root.value());
+        cache->context.emplace(std::move(created.value()));
+    }
+
+    auto cached = cache->expressions.find(expression);
+    if (!cached)
+    {
+        auto compiled = XPathExpression::compile(expression);
+        if (!compiled)
+            return std::unexpected{compiled.error()};
+        cached = cache->expressions.insert(expression, std::move(compiled.value()));
+    }
+    return cache->context->evaluate(*cached, context);
+}
+} // namespace cpplibxml2
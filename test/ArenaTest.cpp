@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <cpplibxml2.hpp>
+#include <xpath.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef CPPLIBXML2_ENABLE_ARENA
+
+namespace
+{
+std::string makeCatalog(const int books)
+{
+    std::string xml = R"(<?xml version="1.0"?><catalog>)";
+    for (int i = 0; i < books; ++i)
+        xml += R"(<book id="bk)" + std::to_string(i) + R"("><title>Title &amp; )" + std::to_string(i) +
+               "</title><price>" + std::to_string(i) + ".5</price></book>";
+    xml += "</catalog>";
+    return xml;
+}
+} // namespace
+
+TEST(Arena, MatchesRegularParse)
+{
+    const auto xml = makeCatalog(500);
+    const auto regular = cpplibxml2::Doc::parse(xml);
+    ASSERT_TRUE(regular);
+    const auto arena = cpplibxml2::Doc::parseInArena(xml);
+    ASSERT_TRUE(arena);
+    EXPECT_EQ(arena.value().dump().value(), regular.value().dump().value());
+
+    const auto last = arena.value().query("string(/catalog/book[last()]/title)");
+    ASSERT_TRUE(last);
+    EXPECT_EQ(last.value().string(), "Title & 499");
+}
+
+TEST(Arena, Errors)
+{
+    const auto empty = cpplibxml2::Doc::parseInArena("");
+    ASSERT_FALSE(empty);
+    EXPECT_STREQ(empty.error().what(), "Document is empty.");
+
+    const auto broken = cpplibxml2::Doc::parseInArena("<a><b></a>");
+    ASSERT_FALSE(broken);
+    EXPECT_STREQ(broken.error().what(), "Document not parsed successfully.");
+
+    // Regular parsing and its error reporting keep working after the arena was released.
+    EXPECT_FALSE(cpplibxml2::Doc::parse("<a><b></a>"));
+    EXPECT_TRUE(cpplibxml2::Doc::parse(makeCatalog(3)));
+}
+
+TEST(Arena, ChunksAreReused)
+{
+    const auto xml = makeCatalog(2000);
+    for (int i = 0; i < 50; ++i)
+    {
+        auto doc = cpplibxml2::Doc::parseInArena(xml);
+        ASSERT_TRUE(doc);
+        EXPECT_EQ(doc.value().root().value().findChild("book").value().attribute("id"), "bk0");
+        auto regular = cpplibxml2::Doc::parse(xml);
+        ASSERT_TRUE(regular);
+    }
+}
+
+TEST(Arena, ConcurrentArenas)
+{
+    const auto xml = makeCatalog(200);
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&xml] {
+            for (int i = 0; i < 50; ++i)
+            {
+                auto doc = cpplibxml2::Doc::parseInArena(xml);
+                EXPECT_TRUE(doc);
+                auto regular = cpplibxml2::Doc::parse(xml);
+                EXPECT_TRUE(regular);
+            }
+        });
+    }
+}
+
+#else
+
+TEST(Arena, Disabled)
+{
+    GTEST_SKIP() << "Built without CPPLIBXML2_ENABLE_ARENA";
+}
+
+#endif
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <batchParser.hpp>
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const std::filesystem::path exampleFile{"testData/example.xml"};
+static const std::filesystem::path nsExampleFile{"testData/nsExample.xml"};
+
+namespace
+{
+std::vector<std::string> makeMessages(const int count)
+{
+    std::vector<std::string> messages;
+    for (int i = 0; i < count; ++i)
+        messages.push_back(R"(<?xml version="1.0"?><msg><id>)" + std::to_string(i) + "</id></msg>");
+    return messages;
+}
+} // namespace
+
+class BatchParserTest : public testing::TestWithParam<std::size_t>
+{
+};
+
+TEST_P(BatchParserTest, ResultsInInputOrder)
+{
+    const auto messages = makeMessages(200);
+    std::vector<std::string_view> inputs{messages.begin(), messages.end()};
+    inputs[17] = "<broken>";
+
+    cpplibxml2::BatchParser batch{GetParam()};
+    EXPECT_EQ(batch.threads(), GetParam());
+    const auto results = batch.parse(inputs);
+    ASSERT_EQ(results.size(), inputs.size());
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        if (i == 17)
+        {
+            ASSERT_FALSE(results[i]);
+            EXPECT_STREQ(results[i].error().what(), "Document not parsed successfully.");
+            continue;
+        }
+        ASSERT_TRUE(results[i]) << i;
+        EXPECT_EQ(results[i].value().root().value().findChild("id").value().valueAs<std::size_t>(), i);
+    }
+}
+
+TEST_P(BatchParserTest, ParseFiles)
+{
+    const std::vector<std::filesystem::path> paths{exampleFile, nsExampleFile, "testData/doesNotExist.xml",
+                                                   exampleFile};
+    cpplibxml2::BatchParser batch{GetParam()};
+    const auto results = batch.parseFiles(paths);
+    ASSERT_EQ(results.size(), paths.size());
+    ASSERT_TRUE(results[0]);
+    EXPECT_EQ(results[0].value().root().value().name(), "catalog");
+    ASSERT_TRUE(results[1]);
+    EXPECT_EQ(results[1].value().root().value().name(), "ConnectorServices");
+    ASSERT_FALSE(results[2]);
+    EXPECT_STREQ(results[2].error().what(), "Document don't exist.");
+    ASSERT_TRUE(results[3]);
+    EXPECT_EQ(results[3].value().dump().value(), results[0].value().dump().value());
+}
+
+TEST_P(BatchParserTest, CallbackSeesEveryInputOnce)
+{
+    const auto messages = makeMessages(100);
+    const std::vector<std::string_view> inputs{messages.begin(), messages.end()};
+
+    std::set<std::size_t> seen;
+    cpplibxml2::BatchParser batch{GetParam()};
+    batch.parse(inputs, [&](const std::size_t index, cpplibxml2::BatchParser::Result &&result) {
+        ASSERT_TRUE(result);
+        EXPECT_EQ(result.value().root().value().findChild("id").value().valueAs<std::size_t>(), index);
+        EXPECT_TRUE(seen.insert(index).second);
+    });
+    EXPECT_EQ(seen.size(), inputs.size());
+}
+
+TEST_P(BatchParserTest, CallbackExceptionStopsBatch)
+{
+    const auto messages = makeMessages(100);
+    const std::vector<std::string_view> inputs{messages.begin(), messages.end()};
+
+    cpplibxml2::BatchParser batch{GetParam()};
+    EXPECT_THROW(batch.parse(inputs, [](const std::size_t index, cpplibxml2::BatchParser::Result &&) {
+        if (index == 10)
+            throw std::runtime_error{"stop"};
+    }),
+                 std::runtime_error);
+
+    // The parser stays usable after a failed batch.
+    const auto results = batch.parse(inputs);
+    EXPECT_TRUE(std::ranges::all_of(results, [](const auto &result) { return result.has_value(); }));
+}
+
+TEST_P(BatchParserTest, DocsOutliveTheirBatch)
+{
+    const auto messages = makeMessages(200);
+    const std::vector<std::string_view> inputs{messages.begin(), messages.end()};
+
+    cpplibxml2::BatchParser batch{GetParam()};
+    for (int round = 0; round < 4; ++round)
+    {
+        // The previous batch is destroyed on another thread while this one runs.
+        std::jthread destroyer{[results = batch.parse(inputs)]() mutable {
+            for (auto &result : results)
+            {
+                EXPECT_EQ(result.value().root().value().name(), "msg");
+                result = std::unexpected{cpplibxml2::RuntimeError{"destroyed"}};
+            }
+        }};
+        const auto results = batch.parse(inputs);
+        EXPECT_TRUE(std::ranges::all_of(results, [](const auto &result) { return result.has_value(); }));
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Threads, BatchParserTest, testing::Values(1, 2, 4, 8));
+
+TEST(BatchParser, EmptyBatch)
+{
+    cpplibxml2::BatchParser batch;
+    EXPECT_GE(batch.threads(), 1u);
+    EXPECT_TRUE(batch.parse(std::span<const std::string_view>{}).empty());
+}
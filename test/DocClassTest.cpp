@@ -14,6 +14,8 @@
 #include <filesystem>
 #include <fstream>
 #include <locale>
+#include <sstream>
+#include <stdexcept>
 
 static const std::filesystem::path exampleFile{"testData/example.xml"};
 static const std::filesystem::path emptyFile{"testData/empty.xml"};
@@ -41,6 +43,31 @@ TEST(DocClass, parseEmptyFile) {
     ASSERT_STREQ(DocResult.error().what(), "Document not parsed successfully.");
 }
 
+TEST(DocClass, parseMappedFile)
+{
+    ASSERT_TRUE(std::filesystem::exists(exampleFile));
+    const auto mapped = cpplibxml2::Doc::parseMappedFile(exampleFile);
+    ASSERT_TRUE(mapped);
+    const auto regular = cpplibxml2::Doc::parseFile(exampleFile);
+    ASSERT_TRUE(regular);
+    EXPECT_EQ(mapped.value().dump().value(), regular.value().dump().value());
+}
+
+TEST(DocClass, parseMappedFileMissing)
+{
+    const auto DocResult = cpplibxml2::Doc::parseMappedFile("testData/doesNotExist.xml");
+    ASSERT_FALSE(DocResult);
+    ASSERT_STREQ(DocResult.error().what(), "Document don't exist.");
+}
+
+TEST(DocClass, parseMappedEmptyFile)
+{
+    ASSERT_TRUE(std::filesystem::exists(emptyFile));
+    const auto DocResult = cpplibxml2::Doc::parseMappedFile(emptyFile);
+    ASSERT_FALSE(DocResult);
+    ASSERT_STREQ(DocResult.error().what(), "Document not parsed successfully.");
+}
+
 TEST(DocClass, MoveOperators) {
     ASSERT_TRUE(std::filesystem::exists(exampleFile));
     auto doc = cpplibxml2::Doc::parseFile(exampleFile);
@@ -82,6 +109,72 @@ TEST(DocClass, parseRandomString) {
     ASSERT_STREQ(DocResult.error().what(), "Document not parsed successfully.");
 }
 
+TEST(DocClass, parseStream)
+{
+    auto input = std::ifstream{exampleFile, std::ios::binary};
+    ASSERT_TRUE(input.is_open());
+    const auto doc = cpplibxml2::Doc::parse(input);
+    ASSERT_TRUE(doc.has_value()) << doc.error().what();
+    EXPECT_EQ(doc->root().value().name().value(), "catalog");
+}
+
+TEST(DocClass, parseStreamInChunks)
+{
+    // Far more than libxml2 reads per callback, so the document spans many chunks.
+    std::string xml = "<records>";
+    for (int i = 0; i < 20000; ++i)
+        xml.append("<record id=\"").append(std::to_string(i)).append("\">value</record>");
+    xml.append("</records>");
+
+    auto input = std::istringstream{xml};
+    const auto doc = cpplibxml2::Doc::parse(input);
+    ASSERT_TRUE(doc.has_value()) << doc.error().what();
+    EXPECT_EQ(std::ranges::distance(doc->root().value().elements()), 20000);
+}
+
+TEST(DocClass, parseEmptyStream)
+{
+    auto input = std::istringstream{};
+    const auto doc = cpplibxml2::Doc::parse(input);
+    ASSERT_FALSE(doc);
+    EXPECT_STREQ(doc.error().what(), "Document is empty.");
+}
+
+TEST(DocClass, parseInvalidStream)
+{
+    auto input = std::istringstream{"<root><unclosed></root>"};
+    const auto doc = cpplibxml2::Doc::parse(input, cpplibxml2::ParserOptions::NoError);
+    ASSERT_FALSE(doc);
+    EXPECT_STREQ(doc.error().what(), "Document not parsed successfully.");
+}
+
+TEST(DocClass, parseExceptionEnabledStream)
+{
+    auto input = std::istringstream{"<root><child>data</child></root>"};
+    input.exceptions(std::ios::failbit | std::ios::badbit);
+    const auto doc = cpplibxml2::Doc::parse(input);
+    ASSERT_TRUE(doc.has_value()) << doc.error().what();
+    EXPECT_EQ(doc->root().value().findChild("child").value().value(), "data");
+}
+
+TEST(DocClass, parseFailingStream)
+{
+    struct FailingBuffer : std::streambuf
+    {
+        int_type underflow() override
+        {
+            throw std::runtime_error{"read failed"};
+        }
+    };
+
+    FailingBuffer buffer;
+    auto input = std::istream{&buffer};
+    input.exceptions(std::ios::badbit);
+    const auto doc = cpplibxml2::Doc::parse(input);
+    ASSERT_FALSE(doc);
+    EXPECT_STREQ(doc.error().what(), "Failed to read input.");
+}
+
 TEST(DocClass, dumpXML)
 {
     constexpr auto orgXML = std::string_view{"<root><child>data</child></root>"};
@@ -256,4 +349,37 @@ TEST(DocClass, SaveToFile_InvalidPath)
     const auto badPath = std::filesystem::path("/invalid_dir/test_output.xml");
     const auto result = doc->saveToFile(badPath);
     ASSERT_FALSE(result.has_value());
-}
\ No newline at end of file
+}
+
+TEST(DocClass, Create)
+{
+    auto doc = cpplibxml2::Doc::create("export");
+    ASSERT_TRUE(doc.has_value());
+    EXPECT_EQ(doc->root().value().name().value(), "export");
+    EXPECT_EQ(doc->dump().value(), "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<export/>\n");
+
+    const auto empty = cpplibxml2::Doc::create("");
+    ASSERT_FALSE(empty.has_value());
+    EXPECT_STREQ(empty.error().what(), "Node name is empty.");
+}
+
+TEST(DocClass, InternedNames)
+{
+    auto doc = cpplibxml2::Doc::create("export").value();
+    const auto root = doc.root().value();
+    EXPECT_FALSE(doc.nameKey("record").view().empty());
+
+    const auto record = doc.intern("record");
+    for (int i = 0; i < 3; ++i)
+        ASSERT_TRUE(root.addChild(record).has_value());
+
+    EXPECT_EQ(std::ranges::distance(root.elements(record)), 3);
+    EXPECT_EQ(std::ranges::distance(root.elements(doc.nameKey("record"))), 3);
+    EXPECT_EQ(doc.dump().value(),
+              "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<export><record/><record/><record/></export>\n");
+
+    // A key of another document falls back to the name.
+    auto other = cpplibxml2::Doc::create("other").value();
+    ASSERT_TRUE(other.root().value().addChild(record).has_value());
+    EXPECT_TRUE(other.root().value().findChild("record").has_value());
+}
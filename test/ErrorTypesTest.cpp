@@ -22,3 +22,8 @@ TEST(ErrorTest, ThrowAndCatch) {
         EXPECT_STREQ(e.what(), "Thrown error");
     }
 }
+
+TEST(ErrorTest, ConversionErrorToString) {
+    EXPECT_EQ(cpplibxml2::to_string(cpplibxml2::ConversionError::Empty), "Value is empty.");
+    EXPECT_EQ(cpplibxml2::to_string(cpplibxml2::ConversionError::OutOfRange), "Value is out of range.");
+}
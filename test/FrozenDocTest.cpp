@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <frozenDoc.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr int threadCount = 8;
+constexpr int iterations = 50;
+
+std::string makeReferenceData()
+{
+    std::string xml = R"(<?xml version="1.0"?><ref:data xmlns:ref="urn:reference" version="3">)";
+    for (int i = 0; i < 200; ++i)
+    {
+        xml += R"(<ref:entry key="k)" + std::to_string(i) + R"(" weight=")" + std::to_string(i % 7) +
+               R"("><ref:name>entry )" + std::to_string(i) + "</ref:name><ref:value>" + std::to_string(i * 3) +
+               "</ref:value><ref:note>mixed <b>content</b> here</ref:note></ref:entry>";
+    }
+    xml += "</ref:data>";
+    return xml;
+}
+
+/**
+ * Exercises the read-only API on one entry and returns a checksum, so that results can be compared between threads.
+ */
+long long readEntry(const cpplibxml2::FrozenDoc &doc, const cpplibxml2::Node entry, const cpplibxml2::NameKey &value)
+{
+    long long checksum = 0;
+    checksum += static_cast<long long>(entry.name().value().size());
+    checksum += entry.findChild(value).value().valueAs<long long>().value();
+    checksum += entry.findChild("value").value().valueAsLongLong().value();
+    checksum += static_cast<long long>(entry.findChild("name").value().value().value().size());
+    checksum += static_cast<long long>(entry.findChild("note").value().value().value().size());
+    for (const auto &[name, text] : entry.getProperties())
+        checksum += static_cast<long long>(name.size() + text.size());
+    checksum += entry.attributeAs<int>("weight").value();
+    checksum += static_cast<long long>(cpplibxml2::AttributeIndex{entry}.find("key").value().size());
+    checksum += std::ranges::distance(entry.descendants());
+    checksum += static_cast<long long>(doc.query("count(ref:name)", entry).value().number());
+    return checksum;
+}
+} // namespace
+
+TEST(FrozenDoc, QueryMatchesDoc)
+{
+    auto parsed = cpplibxml2::Doc::parse(makeReferenceData());
+    ASSERT_TRUE(parsed);
+    const auto expected = parsed.value().query("sum(//ref:value)");
+    ASSERT_TRUE(expected);
+    const auto sum = expected.value().number();
+
+    const cpplibxml2::FrozenDoc doc{std::move(parsed.value())};
+    const auto result = doc.query("sum(//ref:value)");
+    ASSERT_TRUE(result);
+    EXPECT_DOUBLE_EQ(result.value().number(), sum);
+
+    const auto compiled = cpplibxml2::XPathExpression::compile("//ref:entry[@weight='0']");
+    ASSERT_TRUE(compiled);
+    const auto entries = doc.query(compiled.value());
+    ASSERT_TRUE(entries);
+    EXPECT_EQ(entries.value().size(), 29u);
+
+    EXPECT_FALSE(doc.query("//["));
+}
+
+TEST(FrozenDoc, ConcurrentReaders)
+{
+    auto parsed = cpplibxml2::Doc::parse(makeReferenceData());
+    ASSERT_TRUE(parsed);
+    const cpplibxml2::FrozenDoc doc{std::move(parsed.value())};
+    const auto value = doc.nameKey("value");
+
+    long long reference = 0;
+    for (const auto entry : doc.root().value().elements())
+        reference += readEntry(doc, entry, value);
+
+    std::atomic<int> mismatches{0};
+    std::vector<std::jthread> readers;
+    for (int t = 0; t < threadCount; ++t)
+    {
+        readers.emplace_back([&, t] {
+            for (int i = 0; i < iterations; ++i)
+            {
+                long long checksum = 0;
+                for (const auto entry : doc.root().value().elements())
+                    checksum += readEntry(doc, entry, value);
+                if (checksum != reference)
+                    ++mismatches;
+
+                const auto weighted = doc.query("//ref:entry[@weight='" + std::to_string((t + i) % 7) + "']");
+                if (!weighted || weighted.value().empty())
+                    ++mismatches;
+            }
+        });
+    }
+    readers.clear();
+    EXPECT_EQ(mismatches.load(), 0);
+}
+
+TEST(FrozenDoc, ConcurrentQueriesEvictEachOther)
+{
+    auto parsed = cpplibxml2::Doc::parse(makeReferenceData());
+    ASSERT_TRUE(parsed);
+    const cpplibxml2::FrozenDoc doc{std::move(parsed.value())};
+
+    // Far more distinct expressions than the cache keeps, so threads evict expressions others are evaluating.
+    std::atomic<int> mismatches{0};
+    std::vector<std::jthread> readers;
+    for (int t = 0; t < threadCount; ++t)
+    {
+        readers.emplace_back([&, t] {
+            for (int i = 0; i < 200; ++i)
+            {
+                const auto key = (t * 200 + i) % 250;
+                const auto value = doc.query("sum(//ref:entry[@key='k" + std::to_string(key) + "']/ref:value)");
+                if (!value || value.value().number() != (key < 200 ? 3.0 * key : 0.0))
+                    ++mismatches;
+            }
+        });
+    }
+    readers.clear();
+    EXPECT_EQ(mismatches.load(), 0);
+}
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <cpplibxml2.hpp>
+#include <parser.hpp>
+#include <reader.hpp>
+
+#include <cstdlib>
+#include <istream>
+#include <limits>
+#include <optional>
+#include <string>
+
+// These tests generate inputs beyond 2 GiB and take a while, set CPPLIBXML2_LARGE_TESTS to run them.
+
+namespace
+{
+constexpr auto largeSize = static_cast<std::size_t>(std::numeric_limits<int>::max()) + (std::size_t{64} << 20);
+constexpr auto options = cpplibxml2::ParserOptions::NoBlanks;
+
+bool largeTestsEnabled()
+{
+    return std::getenv("CPPLIBXML2_LARGE_TESTS") != nullptr;
+}
+
+/**
+ * A record padded with whitespace inside the tag, which the parser drops, so the tree stays small however large the
+ * input is.
+ */
+void appendRecord(std::string &xml, const std::size_t i)
+{
+    xml.append("<record id=\"").append(std::to_string(i)).append("\"");
+    xml.append(4000, ' ').append("/>\n");
+}
+
+/**
+ * Generates a document of at least `size` bytes and returns the number of records in it.
+ */
+std::size_t generate(std::string &xml, const std::size_t size)
+{
+    xml.reserve(size + 8192);
+    xml.assign("<records>");
+    std::size_t records = 0;
+    while (xml.size() < size)
+        appendRecord(xml, records++);
+    xml.append("</records>");
+    return records;
+}
+
+/**
+ * Produces a document of at least `size` bytes on the fly, so the input itself is never held in memory.
+ */
+class GeneratingBuffer : public std::streambuf
+{
+    std::size_t size;
+    std::size_t produced = 0;
+    std::string chunk;
+    bool closed = false;
+
+  public:
+    std::size_t records = 0;
+
+    explicit GeneratingBuffer(const std::size_t total) : size(total)
+    {
+    }
+
+  protected:
+    int_type underflow() override
+    {
+        if (this->closed)
+            return traits_type::eof();
+
+        this->chunk.clear();
+        if (this->produced == 0)
+            this->chunk.append("<records>");
+        while (this->chunk.size() < 65536 && this->produced + this->chunk.size() < this->size)
+            appendRecord(this->chunk, this->records++);
+        if (this->produced + this->chunk.size() >= this->size)
+        {
+            this->chunk.append("</records>");
+            this->closed = true;
+        }
+        this->produced += this->chunk.size();
+        this->setg(this->chunk.data(), this->chunk.data(), this->chunk.data() + this->chunk.size());
+        return traits_type::to_int_type(this->chunk.front());
+    }
+};
+
+void expectRecords(const cpplibxml2::Doc &doc, const std::size_t records)
+{
+    const auto root = doc.root().value();
+    std::size_t count = 0;
+    std::optional<std::string_view> lastId;
+    for (const auto &record : root.elements())
+    {
+        ++count;
+        lastId = record.attribute("id");
+    }
+    EXPECT_EQ(count, records);
+    EXPECT_EQ(lastId, std::to_string(records - 1));
+}
+} // namespace
+
+TEST(LargeInput, ParseMemory)
+{
+    if (!largeTestsEnabled())
+        GTEST_SKIP() << "Set CPPLIBXML2_LARGE_TESTS to run";
+
+    std::string xml;
+    const auto records = generate(xml, largeSize);
+    ASSERT_GT(xml.size(), static_cast<std::size_t>(std::numeric_limits<int>::max()));
+
+    {
+        const auto doc = cpplibxml2::Doc::parse(xml, options);
+        ASSERT_TRUE(doc.has_value()) << doc.error().what();
+        expectRecords(doc.value(), records);
+    }
+    {
+        const auto doc = cpplibxml2::Parser::local().parse(xml, options);
+        ASSERT_TRUE(doc.has_value()) << doc.error().what();
+        expectRecords(doc.value(), records);
+    }
+}
+
+TEST(LargeInput, Reader)
+{
+    if (!largeTestsEnabled())
+        GTEST_SKIP() << "Set CPPLIBXML2_LARGE_TESTS to run";
+
+    std::string xml;
+    const auto records = generate(xml, largeSize);
+
+    auto reader = cpplibxml2::Reader::open(xml, options).value();
+    std::size_t elements = 0;
+    while (reader.read().value())
+    {
+        if (reader.nodeType() == cpplibxml2::ReaderNodeType::StartElement)
+            ++elements;
+    }
+    // The root and the records.
+    EXPECT_EQ(elements, records + 1);
+}
+
+TEST(LargeInput, ParseStream)
+{
+    if (!largeTestsEnabled())
+        GTEST_SKIP() << "Set CPPLIBXML2_LARGE_TESTS to run";
+
+    // Beyond 4 GiB, past any 32-bit offset.
+    GeneratingBuffer buffer{std::size_t{5} << 30};
+    auto input = std::istream{&buffer};
+    const auto doc = cpplibxml2::Doc::parse(input, options);
+    ASSERT_TRUE(doc.has_value()) << doc.error().what();
+    expectRecords(doc.value(), buffer.records);
+}
@@ -39,6 +39,27 @@ TEST(NodeClass, MoveAssignmentOperator)
     Root2.value() = std::move(Root1.value());
 }
 
+TEST(NodeClass, CopyHandle)
+{
+    static_assert(std::is_trivially_copyable_v<cpplibxml2::Node>);
+    static_assert(sizeof(cpplibxml2::Node) == sizeof(void *));
+
+    const auto DocRes = cpplibxml2::Doc::parse(R"(<?xml version="1.0"?><root><child>data</child></root>)");
+    ASSERT_TRUE(DocRes);
+    const auto Root = DocRes.value().root();
+    ASSERT_TRUE(Root);
+
+    const cpplibxml2::Node copy = Root.value();
+    EXPECT_EQ(copy, Root.value());
+    ASSERT_TRUE(copy.name());
+    EXPECT_EQ(copy.name().value(), "root");
+
+    const auto Child = copy.findChild("child");
+    ASSERT_TRUE(Child);
+    EXPECT_NE(Child.value(), copy);
+    EXPECT_EQ(Child.value(), Root.value().findChild("child").value());
+}
+
 TEST(NodeClass, FindChild)
 {
     ASSERT_TRUE(std::filesystem::exists(exampleFile));
@@ -130,6 +151,34 @@ TEST(NodeClass, GetValueNotANumber)
     EXPECT_EQ(PriceNode.value().valueAsDouble().value(), 42.4);
 }
 
+TEST(NodeClass, ValueAs)
+{
+    const auto DocRes = cpplibxml2::Doc::parse(
+        R"(<?xml version="1.0"?><catalog><price> 42 </price><flag>true</flag><mixed>4<!--x-->2</mixed></catalog>)");
+    ASSERT_TRUE(DocRes);
+    const auto Root = DocRes.value().root();
+    ASSERT_TRUE(Root);
+
+    const auto Price = Root.value().findChild("price");
+    ASSERT_TRUE(Price);
+    EXPECT_EQ(Price.value().valueAs<int>().value(), 42);
+    EXPECT_EQ(Price.value().valueAs<unsigned long>().value(), 42ul);
+    EXPECT_DOUBLE_EQ(Price.value().valueAs<double>().value(), 42.0);
+    EXPECT_EQ(Price.value().valueAs<int>(8).value(), 34);
+    EXPECT_EQ(Price.value().valueAs<bool>().error(), cpplibxml2::ConversionError::InvalidFormat);
+
+    const auto Flag = Root.value().findChild("flag");
+    ASSERT_TRUE(Flag);
+    EXPECT_TRUE(Flag.value().valueAs<bool>().value());
+    EXPECT_EQ(Flag.value().valueAs<int>().error(), cpplibxml2::ConversionError::InvalidFormat);
+
+    const auto Mixed = Root.value().findChild("mixed");
+    ASSERT_TRUE(Mixed);
+    EXPECT_EQ(Mixed.value().valueAs<int>().value(), 42);
+
+    EXPECT_EQ(Root.value().valueAs<int>().error(), cpplibxml2::ConversionError::InvalidFormat);
+}
+
 TEST(NodeClass, GetValueOfEmptyNode)
 {
     const auto DocRes = cpplibxml2::Doc::parse(R"(<?xml version="1.0"?><catalog></catalog>)");
@@ -142,6 +191,50 @@ TEST(NodeClass, GetValueOfEmptyNode)
     EXPECT_STREQ(Root.value().value().value().c_str(), "");
 }
 
+TEST(NodeClass, ValueView)
+{
+    const auto DocRes = cpplibxml2::Doc::parse(
+        R"(<?xml version="1.0"?><catalog><price>42.43</price><note><![CDATA[a<b]]></note><empty/></catalog>)");
+    ASSERT_TRUE(DocRes);
+    const auto Root = DocRes.value().root();
+    ASSERT_TRUE(Root);
+
+    const auto Price = Root.value().findChild("price");
+    ASSERT_TRUE(Price);
+    ASSERT_TRUE(Price.value().valueView());
+    EXPECT_EQ(Price.value().valueView().value(), "42.43");
+    EXPECT_EQ(Price.value().valueView().value().data(), Price.value().valueView().value().data());
+
+    const auto Note = Root.value().findChild("note");
+    ASSERT_TRUE(Note);
+    ASSERT_TRUE(Note.value().valueView());
+    EXPECT_EQ(Note.value().valueView().value(), "a<b");
+
+    const auto Empty = Root.value().findChild("empty");
+    ASSERT_TRUE(Empty);
+    ASSERT_TRUE(Empty.value().valueView());
+    EXPECT_TRUE(Empty.value().valueView().value().empty());
+}
+
+TEST(NodeClass, ValueViewMixedContent)
+{
+    const auto DocRes =
+        cpplibxml2::Doc::parse(R"(<?xml version="1.0"?><p>one <b>two</b><!--skip--> three<![CDATA[!]]></p>)");
+    ASSERT_TRUE(DocRes);
+    const auto Root = DocRes.value().root();
+    ASSERT_TRUE(Root);
+
+    const auto Direct = Root.value().valueView();
+    ASSERT_FALSE(Direct);
+    EXPECT_STREQ(Direct.error().what(), "Node content is not contiguous.");
+
+    std::string buffer;
+    const auto Buffered = Root.value().valueView(buffer);
+    ASSERT_TRUE(Buffered);
+    EXPECT_EQ(Buffered.value(), "one two three!");
+    EXPECT_EQ(Buffered.value(), Root.value().value().value());
+}
+
 TEST(NodeClass, GetProperty)
 {
     const auto DocRes =
@@ -178,6 +271,61 @@ TEST(NodeClass, GetProperties)
         std::ranges::any_of(properties, [](const auto &in) { return in.first == "class" && in.second == "World"; }));
 }
 
+TEST(NodeClass, AttributeAs)
+{
+    const auto DocRes = cpplibxml2::Doc::parse(
+        R"(<?xml version="1.0"?><item id="42" price=" 9.5 " active="true" code="ff" xmlns:x="urn:x" x:id="7" bad="n/a"/>)");
+    ASSERT_TRUE(DocRes);
+    const auto Item = DocRes.value().root();
+    ASSERT_TRUE(Item);
+
+    EXPECT_EQ(Item.value().attribute("id"), "42");
+    EXPECT_FALSE(Item.value().attribute("missing"));
+    EXPECT_EQ(Item.value().attributeAs<int>("id").value(), 42);
+    EXPECT_DOUBLE_EQ(Item.value().attributeAs<double>("price").value(), 9.5);
+    EXPECT_TRUE(Item.value().attributeAs<bool>("active").value());
+    EXPECT_EQ(Item.value().attributeAs<unsigned>("code", 16).value(), 255u);
+    EXPECT_EQ(Item.value().attributeAs<int>("bad").error(), cpplibxml2::ConversionError::InvalidFormat);
+    EXPECT_EQ(Item.value().attributeAs<int>("missing").error(), cpplibxml2::ConversionError::NoValue);
+
+    EXPECT_EQ(Item.value().attributeAs<int>("id", "urn:x").value(), 7);
+    EXPECT_EQ(Item.value().attributeAs<int>("id", "").value(), 42);
+    EXPECT_EQ(Item.value().attributeAs<int>("id", "urn:y").error(), cpplibxml2::ConversionError::NoValue);
+
+    const auto Namespaced = Item.value().findProperty("id", "urn:x");
+    ASSERT_TRUE(Namespaced);
+    EXPECT_EQ(Namespaced.value().first, "id");
+    EXPECT_EQ(Namespaced.value().second, "7");
+    EXPECT_FALSE(Item.value().findProperty("price", "urn:x"));
+}
+
+TEST(NodeClass, AttributeIndex)
+{
+    std::string xml = R"(<?xml version="1.0"?><wide xmlns:x="urn:x")";
+    for (int i = 0; i < 48; ++i)
+        xml += " a" + std::to_string(i) + "=\"" + std::to_string(i * 2) + "\"";
+    xml += R"( x:a0="ns"/>)";
+    const auto DocRes = cpplibxml2::Doc::parse(xml);
+    ASSERT_TRUE(DocRes);
+    const auto Wide = DocRes.value().root();
+    ASSERT_TRUE(Wide);
+
+    const cpplibxml2::AttributeIndex index{Wide.value()};
+    EXPECT_EQ(index.size(), 49u);
+    for (int i = 0; i < 48; ++i)
+    {
+        const auto name = std::string{"a"}.append(std::to_string(i));
+        EXPECT_EQ(index.find(name), Wide.value().attribute(name));
+        EXPECT_EQ(index.as<int>(name).value(), i * 2);
+    }
+    EXPECT_EQ(index.find("a0"), "0");
+    EXPECT_EQ(index.find("a0", "urn:x"), "ns");
+    EXPECT_FALSE(index.find("a48"));
+    EXPECT_EQ(index.as<int>("a48").error(), cpplibxml2::ConversionError::NoValue);
+
+    EXPECT_TRUE(cpplibxml2::AttributeIndex{}.empty());
+}
+
 TEST(NodeClass, GetNamespace)
 {
     ASSERT_TRUE(std::filesystem::exists(nsExampleFile));
@@ -242,3 +390,39 @@ TEST(NodeClass, AddValueToNode)
     ASSERT_TRUE(newNode.value().value());
     EXPECT_STREQ(newNode.value().value().value().c_str(), "Hello World!");
 }
+
+TEST(NodeClass, AddValueTakesLength)
+{
+    const auto doc = cpplibxml2::Doc::create("catalog").value();
+    const auto node = doc.root().value().addChild("price").value();
+    const std::string_view value = std::string_view{"12.50 EUR"}.substr(0, 5);
+    node.addValue(value);
+    EXPECT_EQ(node.value().value(), "12.50");
+}
+
+TEST(NodeClass, BuildTree)
+{
+    const auto doc = cpplibxml2::Doc::create("catalog").value();
+    const auto root = doc.root().value();
+    const std::string_view name = std::string_view{"bookshelf"}.substr(0, 4);
+    const auto book = root.addChild(name).value();
+    EXPECT_EQ(book.name().value(), "book");
+
+    ASSERT_TRUE(book.setAttribute("id", "bk1").has_value());
+    ASSERT_TRUE(book.setAttribute("lang", "en").has_value());
+    ASSERT_TRUE(book.setAttribute("id", "bk2 & co").has_value());
+    const std::vector<std::pair<std::string, std::string>> fields{{"title", "A < B"}, {"year", "2024"}, {"note", ""}};
+    ASSERT_TRUE(book.addChildren(fields).has_value());
+    ASSERT_TRUE(book.addChild("price", "&amp;").has_value());
+    ASSERT_TRUE(root.appendText("tail ").has_value());
+    ASSERT_TRUE(root.appendText("text").has_value());
+
+    EXPECT_EQ(book.attribute("id"), "bk2 & co");
+    EXPECT_EQ(book.getProperties().size(), 2u);
+    EXPECT_EQ(doc.dump().value(), "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                                  "<catalog><book lang=\"en\" id=\"bk2 &amp; co\"><title>A &lt; B</title>"
+                                  "<year>2024</year><note/><price>&amp;amp;</price></book>tail text</catalog>\n");
+
+    // Both text appends were merged into one node.
+    EXPECT_EQ(std::ranges::distance(root.children()), 2);
+}
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+
+#include <cpplibxml2.hpp>
+
+#include <algorithm>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <vector>
+
+static const std::filesystem::path exampleFile{"testData/example.xml"};
+
+namespace
+{
+std::vector<std::string> names(const cpplibxml2::NodeRange range)
+{
+    std::vector<std::string> result;
+    for (const auto node : range)
+        result.emplace_back(node.name().value());
+    return result;
+}
+} // namespace
+
+TEST(NodeRange, ElementsMatchGetChildren)
+{
+    ASSERT_TRUE(std::filesystem::exists(exampleFile));
+    const auto DocRes = cpplibxml2::Doc::parseFile(exampleFile);
+    ASSERT_TRUE(DocRes);
+    const auto Root = DocRes.value().root();
+    ASSERT_TRUE(Root);
+
+    const auto children = Root.value().getChildren();
+    ASSERT_TRUE(children);
+    const auto elements = Root.value().elements();
+    EXPECT_EQ(std::ranges::distance(elements), 12);
+    EXPECT_TRUE(std::ranges::equal(elements, children.value()));
+}
+
+TEST(NodeRange, ChildrenIncludeTextNodes)
+{
+    const auto DocRes = cpplibxml2::Doc::parse(R"(<?xml version="1.0"?><root>a<b/>c<!--d--><e/></root>)");
+    ASSERT_TRUE(DocRes);
+    const auto Root = DocRes.value().root();
+    ASSERT_TRUE(Root);
+
+    std::vector<cpplibxml2::NodeType> types;
+    std::ranges::transform(Root.value().children(), std::back_inserter(types), &cpplibxml2::Node::type);
+    EXPECT_EQ(types, (std::vector{cpplibxml2::NodeType::Text, cpplibxml2::NodeType::Element,
+                                  cpplibxml2::NodeType::Text, cpplibxml2::NodeType::Comment,
+                                  cpplibxml2::NodeType::Element}));
+    EXPECT_EQ(names(Root.value().elements()), (std::vector<std::string>{"b", "e"}));
+}
+
+TEST(NodeRange, Siblings)
+{
+    const auto DocRes = cpplibxml2::Doc::parse(R"(<?xml version="1.0"?><root><a/>text<b/><c/></root>)");
+    ASSERT_TRUE(DocRes);
+    const auto A = DocRes.value().root().value().findChild("a");
+    ASSERT_TRUE(A);
+    EXPECT_EQ(names(A.value().siblings()), (std::vector<std::string>{"b", "c"}));
+
+    const auto C = DocRes.value().root().value().findChild("c");
+    ASSERT_TRUE(C);
+    EXPECT_TRUE(C.value().siblings().empty());
+}
+
+TEST(NodeRange, DescendantsArePreOrder)
+{
+    const auto DocRes =
+        cpplibxml2::Doc::parse(R"(<?xml version="1.0"?><root><a><b><c/></b>x<d/></a><e/></root><!--tail-->)");
+    ASSERT_TRUE(DocRes);
+    const auto Root = DocRes.value().root();
+    ASSERT_TRUE(Root);
+    EXPECT_EQ(names(Root.value().descendants()), (std::vector<std::string>{"a", "b", "c", "d", "e"}));
+
+    // Descendants of an inner node never leave its subtree.
+    const auto A = Root.value().findChild("a");
+    ASSERT_TRUE(A);
+    EXPECT_EQ(names(A.value().descendants()), (std::vector<std::string>{"b", "c", "d"}));
+    EXPECT_TRUE(Root.value().findChild("e").value().descendants().empty());
+}
+
+TEST(NodeRange, DescendantsOfExample)
+{
+    ASSERT_TRUE(std::filesystem::exists(exampleFile));
+    const auto DocRes = cpplibxml2::Doc::parseFile(exampleFile);
+    ASSERT_TRUE(DocRes);
+    const auto Root = DocRes.value().root();
+    ASSERT_TRUE(Root);
+    EXPECT_EQ(std::ranges::distance(Root.value().descendants()), 12 + 12 * 6);
+}
+
+TEST(NodeRange, Ancestors)
+{
+    const auto DocRes = cpplibxml2::Doc::parse(R"(<?xml version="1.0"?><root><a><b><c/></b></a></root>)");
+    ASSERT_TRUE(DocRes);
+    const auto Root = DocRes.value().root();
+    ASSERT_TRUE(Root);
+    const auto C = *std::ranges::find_if(Root.value().descendants(),
+                                         [](const cpplibxml2::Node node) { return node.name() == "c"; });
+    EXPECT_EQ(names(C.ancestors()), (std::vector<std::string>{"b", "a", "root"}));
+    EXPECT_TRUE(Root.value().ancestors().empty());
+}
+
+TEST(NodeRange, ComposesWithViews)
+{
+    ASSERT_TRUE(std::filesystem::exists(exampleFile));
+    const auto DocRes = cpplibxml2::Doc::parseFile(exampleFile);
+    ASSERT_TRUE(DocRes);
+    const auto Root = DocRes.value().root();
+    ASSERT_TRUE(Root);
+
+    auto prices = Root.value().descendants() |
+                  std::views::filter([](const cpplibxml2::Node node) { return node.name() == "price"; }) |
+                  std::views::take(3);
+    std::vector<std::string> values;
+    for (const auto price : prices)
+        values.push_back(price.value().value());
+    EXPECT_EQ(values, (std::vector<std::string>{"44.95", "5.95", "5.95"}));
+}
+
+TEST(NodeRange, NameKey)
+{
+    const auto DocRes = cpplibxml2::Doc::parse(
+        R"(<?xml version="1.0"?><root><a>1</a><b>2</b><a>3</a><c/><a>4</a></root>)");
+    ASSERT_TRUE(DocRes);
+    const auto Root = DocRes.value().root();
+    ASSERT_TRUE(Root);
+
+    const auto a = DocRes.value().nameKey("a");
+    EXPECT_EQ(a.view(), "a");
+    const auto Found = Root.value().findChild(a);
+    ASSERT_TRUE(Found);
+    EXPECT_EQ(Found.value(), Root.value().findChild("a").value());
+
+    std::vector<std::string> values;
+    for (const auto node : Root.value().elements(a))
+        values.emplace_back(node.value().value());
+    EXPECT_EQ(values, (std::vector<std::string>{"1", "3", "4"}));
+
+    EXPECT_FALSE(Root.value().findChild(DocRes.value().nameKey("unknown")));
+    EXPECT_TRUE(std::ranges::empty(Root.value().elements(DocRes.value().nameKey("unknown"))));
+}
+
+TEST(NodeRange, NameKeyAfterAddChild)
+{
+    const auto DocRes = cpplibxml2::Doc::parse(R"(<?xml version="1.0"?><root/>)");
+    ASSERT_TRUE(DocRes);
+    const auto Root = DocRes.value().root();
+    ASSERT_TRUE(Root);
+    ASSERT_TRUE(Root.value().addChild("added"));
+
+    const auto Found = Root.value().findChild(DocRes.value().nameKey("added"));
+    ASSERT_TRUE(Found);
+    EXPECT_EQ(Found.value().name().value(), "added");
+}
+
+TEST(NodeRange, NameKeyFromOtherDocument)
+{
+    const auto First = cpplibxml2::Doc::parse(R"(<?xml version="1.0"?><root><item/></root>)");
+    const auto Second = cpplibxml2::Doc::parse(R"(<?xml version="1.0"?><root><other/><item/></root>)");
+    ASSERT_TRUE(First);
+    ASSERT_TRUE(Second);
+
+    // Resolved against another dictionary, so the match falls back to comparing strings.
+    const auto item = First.value().nameKey("item");
+    const auto Found = Second.value().root().value().findChild(item);
+    ASSERT_TRUE(Found);
+    EXPECT_EQ(Found.value().name().value(), "item");
+}
+
+TEST(NodeRange, NameKeyOutlivesDocument)
+{
+    std::optional<cpplibxml2::NameKey> item;
+    {
+        const auto First = cpplibxml2::Doc::parse(R"(<?xml version="1.0"?><root><item/></root>)");
+        ASSERT_TRUE(First);
+        item = First.value().nameKey("item");
+    }
+    const auto copy = *item;
+
+    // The key keeps its dictionary alive, so a new document's dictionary cannot take its place.
+    for (int i = 0; i < 10; ++i)
+    {
+        const auto Next = cpplibxml2::Doc::parse(R"(<?xml version="1.0"?><root><other/><item/></root>)");
+        ASSERT_TRUE(Next);
+        const auto Found = Next.value().root().value().findChild(copy);
+        ASSERT_TRUE(Found);
+        EXPECT_EQ(Found.value().name().value(), "item");
+        EXPECT_EQ(std::ranges::distance(Next.value().root().value().elements(*item)), 1);
+    }
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <outputSink.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::string makeLargeXml()
+{
+    std::string xml = R"(<?xml version="1.0" encoding="UTF-8"?><catalog xmlns:p="urn:price">)";
+    for (int i = 0; i < 2000; ++i)
+    {
+        xml += R"(<item id=")" + std::to_string(i) + R"("><name>item &amp; )" + std::to_string(i) +
+               R"(</name><p:price>)" + std::to_string(i * 3) + "</p:price></item>";
+    }
+    xml += "</catalog>";
+    return xml;
+}
+
+std::string collect(const cpplibxml2::Doc &doc, const bool addWhiteSpaces,
+                    const cpplibxml2::Format format = cpplibxml2::Format::UTF_8)
+{
+    std::string out;
+    auto result = doc.serialize(cpplibxml2::OutputSink{[&out](const std::string_view chunk) {
+                                    out += chunk;
+                                    return true;
+                                }},
+                                addWhiteSpaces, format);
+    EXPECT_TRUE(result.has_value());
+    return out;
+}
+} // namespace
+
+TEST(OutputSink, CallbackMatchesDump)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeLargeXml()).value();
+    EXPECT_EQ(collect(doc, false), doc.dump(false).value());
+    EXPECT_EQ(collect(doc, true), doc.dump(true).value());
+    EXPECT_EQ(collect(doc, false, cpplibxml2::Format::ISO_8859_1),
+              doc.dump(false, cpplibxml2::Format::ISO_8859_1).value());
+}
+
+TEST(OutputSink, CallbackReceivesBoundedChunks)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeLargeXml()).value();
+    std::size_t chunks = 0;
+    std::size_t largest = 0;
+    std::size_t total = 0;
+    auto result = doc.serialize(cpplibxml2::OutputSink{[&](const std::string_view chunk) {
+        ++chunks;
+        largest = std::max(largest, chunk.size());
+        total += chunk.size();
+        return true;
+    }});
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(total, doc.dump().value().size());
+    EXPECT_GT(chunks, 1u);
+    EXPECT_LT(largest, total);
+}
+
+TEST(OutputSink, FixedBufferChunks)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeLargeXml()).value();
+    std::array<char, 1000> buffer{};
+    std::vector<std::size_t> sizes;
+    std::string out;
+    const auto sink = cpplibxml2::OutputSink{buffer, [&](const std::string_view chunk) {
+                                                 EXPECT_EQ(chunk.data(), buffer.data());
+                                                 sizes.push_back(chunk.size());
+                                                 out += chunk;
+                                                 return true;
+                                             }};
+
+    ASSERT_TRUE(doc.serialize(sink).has_value());
+    const auto expected = doc.dump().value();
+    EXPECT_EQ(out, expected);
+    ASSERT_FALSE(sizes.empty());
+    for (std::size_t i = 0; i + 1 < sizes.size(); ++i)
+        EXPECT_EQ(sizes[i], buffer.size());
+    EXPECT_EQ(sizes.back(), expected.size() % buffer.size() ? expected.size() % buffer.size() : buffer.size());
+
+    // The same buffer serves the next serialization.
+    out.clear();
+    ASSERT_TRUE(doc.serialize(sink).has_value());
+    EXPECT_EQ(out, expected);
+}
+
+TEST(OutputSink, Stream)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeLargeXml()).value();
+    std::ostringstream stream;
+    ASSERT_TRUE(doc.serialize(stream, true).has_value());
+    EXPECT_EQ(stream.str(), doc.dump(true).value());
+}
+
+TEST(OutputSink, FileDescriptor)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeLargeXml()).value();
+    const auto path = std::filesystem::temp_directory_path() / "cpplibxml2_output_sink.xml";
+    auto file = std::fopen(path.string().c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    const auto result = doc.serialize(cpplibxml2::OutputSink::fileDescriptor(fileno(file)));
+    std::fclose(file);
+    ASSERT_TRUE(result.has_value());
+
+    std::string written(std::filesystem::file_size(path), '\0');
+    std::ifstream in{path, std::ios::binary};
+    in.read(written.data(), static_cast<std::streamsize>(written.size()));
+    EXPECT_EQ(written, doc.dump().value());
+    in.close();
+    std::filesystem::remove(path);
+}
+
+TEST(OutputSink, CallbackAborts)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeLargeXml()).value();
+    int calls = 0;
+    auto result = doc.serialize(cpplibxml2::OutputSink{[&calls](std::string_view) { return ++calls < 2; }});
+    ASSERT_FALSE(result.has_value());
+    EXPECT_STREQ(result.error().what(), "Failed to write to output sink.");
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(OutputSink, CallbackExceptionIsRethrown)
+{
+    const auto doc = cpplibxml2::Doc::parse(makeLargeXml()).value();
+    EXPECT_THROW((void)doc.serialize(cpplibxml2::OutputSink{[](std::string_view) -> bool {
+                     throw std::runtime_error{"sink full"};
+                 }}),
+                 std::runtime_error);
+}
+
+TEST(OutputSink, NodeSubtree)
+{
+    const auto doc =
+        cpplibxml2::Doc::parse(R"(<?xml version="1.0"?><root><a x="1"><b>text &amp; more</b></a><c/></root>)")
+            .value();
+    const auto a = doc.root().value().findChild("a").value();
+
+    std::ostringstream stream;
+    ASSERT_TRUE(a.serialize(stream).has_value());
+    EXPECT_EQ(stream.str(), R"(<a x="1"><b>text &amp; more</b></a>)");
+
+    std::ostringstream formatted;
+    ASSERT_TRUE(doc.root().value().serialize(formatted, true).has_value());
+    EXPECT_EQ(formatted.str(), "<root>\n  <a x=\"1\">\n    <b>text &amp; more</b>\n  </a>\n  <c/>\n</root>");
+}
+
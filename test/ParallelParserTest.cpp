@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+
+#include <parallelParser.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+/**
+ * A feed with the constructs a cut must not land in: record tags in comments, CDATA sections and processing
+ * instructions, nested records, and namespaces and xml:lang inherited from the root.
+ */
+std::string makeFeed(const int records)
+{
+    std::string xml = R"(<?xml version="1.0" encoding="UTF-8"?>)"
+                      "\n<!-- <item> in the prolog -->\n"
+                      R"(<feed xmlns="urn:feed" xmlns:x="urn:extra" xml:lang="en" version="1">)";
+    for (int i = 0; i < records; ++i)
+    {
+        const auto n = std::to_string(i);
+        xml.append("\n  <item id=\"").append(n).append("\" x:flag=\"").append(std::to_string(i % 2)).append("\">");
+        xml.append("<name xml:lang=\"de\">item &amp; ").append(n).append("</name>");
+        switch (i % 5)
+        {
+        case 0:
+            xml.append("<!-- <item id=\"fake\"> -->");
+            break;
+        case 1:
+            xml.append("<note><![CDATA[<item> is not a tag here]]></note>");
+            break;
+        case 2:
+            xml.append("<?render <item?>");
+            break;
+        case 3:
+            xml.append("<children><item id=\"nested\"><x:value>").append(n).append("</x:value></item></children>");
+            break;
+        default:
+            xml.append("<x:value>").append(n).append("</x:value>");
+            break;
+        }
+        xml.append("</item>");
+    }
+    return xml + "\n</feed>\n<!-- epilog -->\n";
+}
+
+std::string makeGroups()
+{
+    std::string xml = "<feed>";
+    for (int i = 0; i < 400; ++i)
+        xml.append("<group><item n=\"").append(std::to_string(i)).append("\"/><padding>........</padding></group>");
+    return xml + "</feed>";
+}
+
+std::string dumpSerial(const std::string &xml)
+{
+    return cpplibxml2::Doc::parse(xml).value().dump().value();
+}
+} // namespace
+
+class ParallelParserTest : public testing::TestWithParam<std::size_t>
+{
+  protected:
+    cpplibxml2::ParallelParser parser{GetParam()};
+
+    void SetUp() override
+    {
+        this->parser.setMinChunkSize(1024);
+    }
+
+    /**
+     * Checks that the last parse was split into at least `chunks` chunks, or parsed serially on one thread.
+     */
+    static void expectSplit(const std::size_t chunks)
+    {
+        if (GetParam() < 2)
+            EXPECT_EQ(cpplibxml2::detail::lastChunkCount(), 0u);
+        else
+            EXPECT_GE(cpplibxml2::detail::lastChunkCount(), chunks);
+    }
+};
+
+TEST_P(ParallelParserTest, MatchesSerialParse)
+{
+    EXPECT_EQ(this->parser.threads(), GetParam());
+    const auto xml = makeFeed(2000);
+    const auto doc = this->parser.parse(xml, "item");
+    ASSERT_TRUE(doc) << doc.error().what();
+    expectSplit(2);
+    EXPECT_EQ(doc->dump().value(), dumpSerial(xml));
+
+    const auto root = doc->root().value();
+    EXPECT_EQ(std::ranges::distance(root.elements()), 2000);
+    EXPECT_EQ(root.attribute("version"), "1");
+    const auto last = root.getChildren().value().back();
+    EXPECT_EQ(last.attribute("flag", "urn:extra"), "1");
+    EXPECT_EQ(last.findChild("name", "urn:feed").value().value(), "item & 1999");
+}
+
+TEST_P(ParallelParserTest, PrefixedRecords)
+{
+    std::string xml = R"(<ns2:Services xmlns:ns2="urn:services" xmlns="urn:default">)";
+    for (int i = 0; i < 1000; ++i)
+        xml.append("<ns2:Service Name=\"s").append(std::to_string(i)).append("\"><Version>1</Version></ns2:Service>");
+    xml.append("</ns2:Services>");
+
+    const auto doc = this->parser.parse(xml, "ns2:Service");
+    ASSERT_TRUE(doc) << doc.error().what();
+    expectSplit(2);
+    EXPECT_EQ(doc->dump().value(), dumpSerial(xml));
+}
+
+TEST_P(ParallelParserTest, OnlyNestedCandidates)
+{
+    // Every "<item" is nested in a <group>, so every cut is wrong and has to be repaired.
+    const auto xml = makeGroups();
+    const auto doc = this->parser.parse(xml, "item");
+    ASSERT_TRUE(doc) << doc.error().what();
+    // All chunks failed and were parsed again as one.
+    expectSplit(1);
+    EXPECT_EQ(doc->dump().value(), dumpSerial(xml));
+}
+
+TEST_P(ParallelParserTest, RecoverDoesNotHideBadCuts)
+{
+    using cpplibxml2::ParserOptions;
+    const auto options = ParserOptions::Recover | ParserOptions::NoError;
+    cpplibxml2::ParallelParser recovering{GetParam(), options};
+    recovering.setMinChunkSize(1024);
+
+    const auto xml = makeGroups();
+    const auto doc = recovering.parse(xml, "item");
+    ASSERT_TRUE(doc) << doc.error().what();
+    expectSplit(1);
+    EXPECT_EQ(doc->dump().value(), cpplibxml2::Doc::parse(xml, options).value().dump().value());
+
+    // Malformed inputs are recovered by the serial parse.
+    auto broken = makeFeed(1000);
+    broken.insert(broken.find("<item id=\"500\""), "<unclosed>");
+    const auto recovered = recovering.parse(broken, "item");
+    ASSERT_TRUE(recovered) << recovered.error().what();
+    EXPECT_EQ(cpplibxml2::detail::lastChunkCount(), 0u);
+    EXPECT_EQ(recovered->dump().value(), cpplibxml2::Doc::parse(broken, options).value().dump().value());
+}
+
+TEST_P(ParallelParserTest, SerialFallbacks)
+{
+    // A DOCTYPE, ID attributes and an input without records are parsed serially.
+    const auto feed = makeFeed(500);
+    const auto body = feed.substr(feed.find("<feed"));
+    const auto withDoctype = R"(<!DOCTYPE feed [<!ENTITY e "entity">]>)" + body;
+    const auto withIds = std::string{feed}.replace(feed.find("id=\"0\""), 2, "xml:id");
+
+    for (const auto &[xml, record] : {std::pair<std::string, std::string>{withDoctype, "item"},
+                                      std::pair<std::string, std::string>{withIds, "item"},
+                                      std::pair<std::string, std::string>{feed, "missing"}})
+    {
+        const auto doc = this->parser.parse(xml, record);
+        ASSERT_TRUE(doc) << doc.error().what();
+        EXPECT_EQ(cpplibxml2::detail::lastChunkCount(), 0u);
+        EXPECT_EQ(doc->dump().value(), dumpSerial(xml));
+    }
+}
+
+TEST_P(ParallelParserTest, MalformedInput)
+{
+    auto xml = makeFeed(1000);
+    xml.insert(xml.find("<item id=\"500\""), "<unclosed>");
+    const auto doc = this->parser.parse(xml, "item");
+    ASSERT_FALSE(doc);
+    EXPECT_STREQ(doc.error().what(), "Document not parsed successfully.");
+    EXPECT_FALSE(this->parser.parse("", "item"));
+}
+
+TEST_P(ParallelParserTest, ParseFile)
+{
+    const auto path = std::filesystem::temp_directory_path() / "cpplibxml2_parallel.xml";
+    const auto xml = makeFeed(2000);
+    {
+        std::ofstream out{path, std::ios::binary};
+        out << xml;
+    }
+    const auto doc = this->parser.parseFile(path, "item");
+    ASSERT_TRUE(doc) << doc.error().what();
+    expectSplit(2);
+    EXPECT_EQ(doc->dump().value(), cpplibxml2::Doc::parseFile(path).value().dump().value());
+    std::filesystem::remove(path);
+
+    EXPECT_FALSE(this->parser.parseFile("testData/doesNotExist.xml", "item"));
+}
+
+INSTANTIATE_TEST_SUITE_P(Threads, ParallelParserTest, testing::Values(1, 2, 4));
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <cpplibxml2.hpp>
+
+#include <cmath>
+#include <limits>
+
+using cpplibxml2::ConversionError;
+using cpplibxml2::parseValue;
+
+TEST(ParseValue, Integers)
+{
+    EXPECT_EQ(parseValue<int>("42").value(), 42);
+    EXPECT_EQ(parseValue<int>("-42").value(), -42);
+    EXPECT_EQ(parseValue<int>("+42").value(), 42);
+    EXPECT_EQ(parseValue<int>(" \t42\r\n").value(), 42);
+    EXPECT_EQ(parseValue<int>("ff", 16).value(), 255);
+    EXPECT_EQ(parseValue<long long>("9223372036854775807").value(), std::numeric_limits<long long>::max());
+    EXPECT_EQ(parseValue<unsigned long long>("18446744073709551615").value(),
+              std::numeric_limits<unsigned long long>::max());
+    EXPECT_EQ(parseValue<short>("-32768").value(), std::numeric_limits<short>::min());
+}
+
+TEST(ParseValue, IntegerErrors)
+{
+    EXPECT_EQ(parseValue<int>("").error(), ConversionError::Empty);
+    EXPECT_EQ(parseValue<int>("  \n").error(), ConversionError::Empty);
+    EXPECT_EQ(parseValue<int>("42.4").error(), ConversionError::InvalidFormat);
+    EXPECT_EQ(parseValue<int>("42abc").error(), ConversionError::InvalidFormat);
+    EXPECT_EQ(parseValue<int>("4 2").error(), ConversionError::InvalidFormat);
+    EXPECT_EQ(parseValue<int>("Hello").error(), ConversionError::InvalidFormat);
+    EXPECT_EQ(parseValue<int>("+").error(), ConversionError::InvalidFormat);
+    EXPECT_EQ(parseValue<int>("+-1").error(), ConversionError::InvalidFormat);
+    EXPECT_EQ(parseValue<unsigned int>("-1").error(), ConversionError::InvalidFormat);
+    EXPECT_EQ(parseValue<int>("2147483648").error(), ConversionError::OutOfRange);
+    EXPECT_EQ(parseValue<short>("40000").error(), ConversionError::OutOfRange);
+    EXPECT_EQ(parseValue<int>("42", 1).error(), ConversionError::InvalidBase);
+    EXPECT_EQ(parseValue<int>("42", 37).error(), ConversionError::InvalidBase);
+}
+
+TEST(ParseValue, FloatingPoint)
+{
+    EXPECT_FLOAT_EQ(parseValue<float>("42.43").value(), 42.43f);
+    EXPECT_DOUBLE_EQ(parseValue<double>(" -1.5e3 ").value(), -1500.0);
+    EXPECT_DOUBLE_EQ(parseValue<double>("+0.25").value(), 0.25);
+    EXPECT_TRUE(std::isinf(parseValue<double>("INF").value()));
+    EXPECT_TRUE(std::isnan(parseValue<double>("NaN").value()));
+    EXPECT_EQ(parseValue<double>("1.5.2").error(), ConversionError::InvalidFormat);
+    EXPECT_EQ(parseValue<double>("1e400").error(), ConversionError::OutOfRange);
+}
+
+TEST(ParseValue, Boolean)
+{
+    EXPECT_TRUE(parseValue<bool>("true").value());
+    EXPECT_TRUE(parseValue<bool>(" 1 ").value());
+    EXPECT_FALSE(parseValue<bool>("false").value());
+    EXPECT_FALSE(parseValue<bool>("0").value());
+    EXPECT_EQ(parseValue<bool>("TRUE").error(), ConversionError::InvalidFormat);
+    EXPECT_EQ(parseValue<bool>("yes").error(), ConversionError::InvalidFormat);
+    EXPECT_EQ(parseValue<bool>("").error(), ConversionError::Empty);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <parser.hpp>
+
+#include <thread>
+
+static const std::filesystem::path exampleFile{"testData/example.xml"};
+static const std::filesystem::path nsExampleFile{"testData/nsExample.xml"};
+
+TEST(Parser, ParseManyDocuments)
+{
+    cpplibxml2::Parser parser;
+    std::vector<cpplibxml2::Doc> docs;
+    for (int i = 0; i < 100; ++i)
+    {
+        auto doc = parser.parse(R"(<?xml version="1.0"?><msg><id>)" + std::to_string(i) + "</id></msg>");
+        ASSERT_TRUE(doc);
+        docs.push_back(std::move(doc.value()));
+    }
+
+    // Earlier documents stay intact while the context is reused.
+    for (int i = 0; i < 100; ++i)
+    {
+        const auto id = docs[static_cast<std::size_t>(i)].root().value().findChild("id");
+        ASSERT_TRUE(id);
+        EXPECT_EQ(id.value().valueAsInt(), i);
+    }
+}
+
+TEST(Parser, ParseFile)
+{
+    ASSERT_TRUE(std::filesystem::exists(exampleFile));
+    ASSERT_TRUE(std::filesystem::exists(nsExampleFile));
+    cpplibxml2::Parser parser;
+    const auto doc = parser.parseFile(exampleFile);
+    ASSERT_TRUE(doc);
+    EXPECT_EQ(doc.value().root().value().name().value(), "catalog");
+
+    const auto nsDoc = parser.parseFile(nsExampleFile);
+    ASSERT_TRUE(nsDoc);
+    EXPECT_EQ(nsDoc.value().root().value().getNamespace().first, "ns2");
+    EXPECT_EQ(doc.value().dump().value(), cpplibxml2::Doc::parseFile(exampleFile).value().dump().value());
+}
+
+TEST(Parser, ErrorsDoNotPoisonTheContext)
+{
+    cpplibxml2::Parser parser;
+    const auto broken = parser.parse(R"(<?xml version="1.0"?><root><a></b></root>)",
+                                     cpplibxml2::ParserOptions::NoError | cpplibxml2::ParserOptions::NoWarning);
+    ASSERT_FALSE(broken);
+    EXPECT_STREQ(broken.error().what(), "Document not parsed successfully.");
+
+    EXPECT_FALSE(parser.parse(""));
+    EXPECT_FALSE(parser.parseFile("testData/doesNotExist.xml"));
+
+    const auto doc = parser.parse(R"(<?xml version="1.0"?><root><a/></root>)");
+    ASSERT_TRUE(doc);
+    EXPECT_TRUE(doc.value().root().value().findChild("a"));
+}
+
+TEST(Parser, LocalIsPerThread)
+{
+    const auto *mainParser = &cpplibxml2::Parser::local();
+    EXPECT_EQ(mainParser, &cpplibxml2::Parser::local());
+
+    const cpplibxml2::Parser *otherParser = nullptr;
+    std::thread{[&otherParser] {
+        otherParser = &cpplibxml2::Parser::local();
+        auto doc = cpplibxml2::Parser::local().parse(R"(<?xml version="1.0"?><root/>)");
+        EXPECT_TRUE(doc);
+    }}.join();
+    EXPECT_NE(mainParser, otherParser);
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <projection.hpp>
+
+#include <ranges>
+#include <string>
+
+static const std::filesystem::path exampleFile{"testData/example.xml"};
+static const std::filesystem::path nsExampleFile{"testData/nsExample.xml"};
+
+namespace
+{
+constexpr std::string_view directoryNs = "http://ws.gematik.de/conn/ServiceDirectory/v3.1";
+constexpr std::string_view serviceNs = "http://ws.gematik.de/conn/ServiceInformation/v2.0";
+
+std::vector<std::string> childNames(const cpplibxml2::Node &node)
+{
+    std::vector<std::string> names;
+    const auto children = node.getChildren();
+    for (const auto &child : children.value())
+        names.emplace_back(child.name().value());
+    return names;
+}
+} // namespace
+
+TEST(Projection, KeepsSelectedPaths)
+{
+    const auto projection = cpplibxml2::Projection::create({"catalog/book/title", "/catalog/book/price"}).value();
+    const auto doc = projection.parseFile(exampleFile);
+    ASSERT_TRUE(doc) << doc.error().what();
+
+    const auto root = doc->root().value();
+    EXPECT_EQ(root.name().value(), "catalog");
+    const auto books = root.getChildren().value();
+    ASSERT_EQ(books.size(), 12u);
+    for (const auto &book : books)
+        EXPECT_EQ(childNames(book), (std::vector<std::string>{"title", "price"}));
+
+    // Ancestors keep their attributes, selected elements their content.
+    EXPECT_EQ(books.front().attribute("id"), "bk101");
+    EXPECT_EQ(books.front().findChild("title").value().value(), "XML Developer's Guide");
+    EXPECT_EQ(books.back().findChild("price").value().valueAs<double>().value(), 49.95);
+}
+
+TEST(Projection, SelectedSubtreesAreComplete)
+{
+    const auto full = cpplibxml2::Doc::parseFile(exampleFile).value();
+    const auto projection = cpplibxml2::Projection::create({"catalog/book"}).value();
+    const auto doc = projection.parseFile(exampleFile).value();
+
+    const auto expected = full.root().value().getChildren().value();
+    const auto books = doc.root().value().getChildren().value();
+    ASSERT_EQ(books.size(), expected.size());
+    for (std::size_t i = 0; i < books.size(); ++i)
+    {
+        EXPECT_EQ(childNames(books[i]), childNames(expected[i]));
+        EXPECT_EQ(books[i].findChild("description").value().value().value(),
+                  expected[i].findChild("description").value().value().value());
+    }
+}
+
+TEST(Projection, Wildcards)
+{
+    const auto projection = cpplibxml2::Projection::create({"*/*/author"}).value();
+    const auto doc = projection.parseFile(exampleFile).value();
+    const auto books = doc.root().value().getChildren().value();
+    ASSERT_EQ(books.size(), 12u);
+    EXPECT_EQ(books.front().findChild("author").value().value(), "Gambardella, Matthew");
+    EXPECT_EQ(childNames(books.back()), std::vector<std::string>{"author"});
+}
+
+TEST(Projection, Namespaces)
+{
+    std::string qualified;
+    qualified.append("{").append(directoryNs).append("}ConnectorServices");
+    for (const auto *step : {"ServiceInformation", "Service", "Abstract"})
+        qualified.append("/{").append(serviceNs).append("}").append(step);
+    const auto withUris = cpplibxml2::Projection::create({qualified}).value();
+    const auto anyNamespace =
+        cpplibxml2::Projection::create({"ConnectorServices/ServiceInformation/Service/Abstract"}).value();
+    for (const auto *projection : {&withUris, &anyNamespace})
+    {
+        const auto doc = projection->parseFile(nsExampleFile).value();
+        const auto root = doc.root().value();
+        EXPECT_EQ(root.getNamespace().second, directoryNs);
+        const auto information = root.getChildren().value();
+        ASSERT_EQ(information.size(), 1u);
+        const auto services = information.front().getChildren().value();
+        ASSERT_FALSE(services.empty());
+        EXPECT_EQ(services.front().attribute("Name"), "PHRManagementService");
+        EXPECT_EQ(services.front().findChild("Abstract", serviceNs).value().value(),
+                  "Schnittstelle zur Administration und Rechtevergabe der Akte");
+    }
+
+    // The elements are in a namespace, so "{}" matches nothing below the root.
+    const auto noNamespace = cpplibxml2::Projection::create({"{}ConnectorServices/{}ServiceInformation"}).value();
+    const auto doc = noNamespace.parseFile(nsExampleFile).value();
+    EXPECT_TRUE(doc.root().value().getChildren().value().empty());
+}
+
+TEST(Projection, RootIsAlwaysKept)
+{
+    const auto projection = cpplibxml2::Projection::create({"feed/item"}).value();
+    const auto doc = projection.parse(R"(<catalog version="2">text<book><title/></book><!-- c --></catalog>)").value();
+    EXPECT_TRUE(doc.dump().value().ends_with("\n<catalog version=\"2\"/>\n")) << doc.dump().value();
+}
+
+TEST(Projection, Sax1IsIgnored)
+{
+    const auto projection = cpplibxml2::Projection::create({"feed/item"}).value();
+    const auto xml = R"(<feed><other><item/></other><item id="1">a</item></feed>)";
+    const auto doc = projection.parse(xml, cpplibxml2::ParserOptions::XML_PARSE_SAX1).value();
+    EXPECT_EQ(doc.dump().value(), projection.parse(xml).value().dump().value());
+    EXPECT_EQ(childNames(doc.root().value()), std::vector<std::string>{"item"});
+}
+
+TEST(Projection, EntitiesInSkippedAndSelectedSubtrees)
+{
+    // The entity is first expanded in a dropped subtree, then in a selected one and in the text of an ancestor.
+    const std::string xml = R"(<!DOCTYPE feed [<!ENTITY e "<b>bold</b> text">]>
+<feed><skip>&e;</skip><keep>&e;</keep>&e;<skip>&e;</skip><keep>&e;</keep></feed>)";
+    const auto projection = cpplibxml2::Projection::create({"feed/keep"}).value();
+    const auto expected = "<feed><keep><b>bold</b> text</keep><keep><b>bold</b> text</keep></feed>";
+
+    const auto expanded = projection.parse(xml).value();
+    EXPECT_NE(expanded.dump().value().find(expected), std::string::npos) << expanded.dump().value();
+
+    const auto references = projection.parse(xml, cpplibxml2::ParserOptions::DtdLoad).value();
+    const auto keep = references.root().value().getChildren().value();
+    ASSERT_EQ(keep.size(), 2u);
+    EXPECT_EQ(keep.back().value(), "bold text");
+}
+
+TEST(Projection, Errors)
+{
+    for (const auto path : {"", "/", "a//b", "a/", "{urn:x", "{urn:x}", "ns2:Service", "a/b*"})
+        EXPECT_FALSE(cpplibxml2::Projection::create({"catalog", path})) << path;
+    EXPECT_STREQ(cpplibxml2::Projection::create({""}).error().what(), "Invalid projection path.");
+
+    const auto projection = cpplibxml2::Projection::create({"feed/item"}).value();
+    // Malformed markup is reported inside dropped subtrees as well.
+    const auto malformed = projection.parse("<feed><other><unclosed></other><item/></feed>");
+    ASSERT_FALSE(malformed);
+    EXPECT_STREQ(malformed.error().what(), "Document not parsed successfully.");
+    EXPECT_STREQ(projection.parse("").error().what(), "Document is empty.");
+    EXPECT_STREQ(projection.parseFile("testData/doesNotExist.xml").error().what(), "Document don't exist.");
+}
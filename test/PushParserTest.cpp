@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <pushParser.hpp>
+
+#include <fstream>
+#include <sstream>
+
+static const std::filesystem::path exampleFile{"testData/example.xml"};
+
+namespace
+{
+std::string readFile(const std::filesystem::path &path)
+{
+    std::ifstream in{path, std::ios::binary};
+    std::ostringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+} // namespace
+
+class PushParserChunks : public testing::TestWithParam<std::size_t>
+{
+};
+
+TEST_P(PushParserChunks, MatchesDocParse)
+{
+    ASSERT_TRUE(std::filesystem::exists(exampleFile));
+    const auto input = readFile(exampleFile);
+    const auto expected = cpplibxml2::Doc::parse(input);
+    ASSERT_TRUE(expected);
+
+    auto ParserRes = cpplibxml2::PushParser::create();
+    ASSERT_TRUE(ParserRes);
+    auto &parser = ParserRes.value();
+    for (std::size_t offset = 0; offset < input.size(); offset += GetParam())
+        ASSERT_TRUE(parser.feed(std::string_view{input}.substr(offset, GetParam())));
+
+    const auto doc = parser.finish();
+    ASSERT_TRUE(doc);
+    EXPECT_EQ(doc.value().dump().value(), expected.value().dump().value());
+    EXPECT_EQ(std::ranges::distance(doc.value().root().value().elements()), 12);
+}
+
+INSTANTIATE_TEST_SUITE_P(PushParser, PushParserChunks, testing::Values(1, 7, 64, 4096, 1 << 20));
+
+TEST(PushParser, ReusableAfterFinish)
+{
+    auto ParserRes = cpplibxml2::PushParser::create();
+    ASSERT_TRUE(ParserRes);
+    auto &parser = ParserRes.value();
+
+    ASSERT_TRUE(parser.feed(R"(<?xml version="1.0"?><first>)"));
+    ASSERT_TRUE(parser.feed("1</first>"));
+    const auto first = parser.finish();
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first.value().root().value().name().value(), "first");
+
+    ASSERT_TRUE(parser.feed(R"(<?xml version="1.0"?><second>2</second>)"));
+    const auto second = parser.finish();
+    ASSERT_TRUE(second);
+    EXPECT_EQ(second.value().root().value().name().value(), "second");
+    EXPECT_EQ(second.value().root().value().value().value(), "2");
+    EXPECT_EQ(first.value().root().value().value().value(), "1");
+}
+
+TEST(PushParser, MalformedInput)
+{
+    auto ParserRes = cpplibxml2::PushParser::create(cpplibxml2::ParserOptions::NoError |
+                                                    cpplibxml2::ParserOptions::NoWarning);
+    ASSERT_TRUE(ParserRes);
+    auto &parser = ParserRes.value();
+
+    ASSERT_TRUE(parser.feed(R"(<?xml version="1.0"?><root><a>)"));
+    const auto fed = parser.feed("</b></root>");
+    ASSERT_FALSE(fed);
+    EXPECT_STREQ(fed.error().what(), "Document not parsed successfully.");
+    EXPECT_FALSE(parser.feed("<more/>"));
+    EXPECT_FALSE(parser.finish());
+
+    // The parser recovers for the next document.
+    ASSERT_TRUE(parser.feed(R"(<?xml version="1.0"?><ok/>)"));
+    EXPECT_TRUE(parser.finish());
+}
+
+TEST(PushParser, TruncatedInput)
+{
+    auto ParserRes = cpplibxml2::PushParser::create(cpplibxml2::ParserOptions::NoError);
+    ASSERT_TRUE(ParserRes);
+    auto &parser = ParserRes.value();
+    ASSERT_TRUE(parser.feed(R"(<?xml version="1.0"?><root><a>)"));
+    const auto doc = parser.finish();
+    ASSERT_FALSE(doc);
+    EXPECT_STREQ(doc.error().what(), "Document not parsed successfully.");
+}
+
+TEST(PushParser, NothingFed)
+{
+    auto ParserRes = cpplibxml2::PushParser::create(cpplibxml2::ParserOptions::NoError);
+    ASSERT_TRUE(ParserRes);
+    EXPECT_FALSE(ParserRes.value().finish());
+}
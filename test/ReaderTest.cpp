@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+
+#include <reader.hpp>
+
+#include <string>
+#include <vector>
+
+static const std::filesystem::path exampleFile{"testData/example.xml"};
+static const std::filesystem::path nsExampleFile{"testData/nsExample.xml"};
+
+TEST(Reader, OpenMissingFile)
+{
+    const auto ReaderRes = cpplibxml2::Reader::openFile("testData/doesNotExist.xml");
+    ASSERT_FALSE(ReaderRes);
+    EXPECT_STREQ(ReaderRes.error().what(), "Document don't exist.");
+}
+
+TEST(Reader, OpenEmptyBuffer)
+{
+    const auto ReaderRes = cpplibxml2::Reader::open("");
+    ASSERT_FALSE(ReaderRes);
+    EXPECT_STREQ(ReaderRes.error().what(), "Document is empty.");
+}
+
+TEST(Reader, StreamsElementsAndText)
+{
+    ASSERT_TRUE(std::filesystem::exists(exampleFile));
+    auto ReaderRes = cpplibxml2::Reader::openFile(exampleFile);
+    ASSERT_TRUE(ReaderRes);
+    auto &reader = ReaderRes.value();
+
+    std::size_t startElements = 0;
+    std::size_t endElements = 0;
+    std::vector<std::string> ids;
+    std::vector<std::string> prices;
+    bool inPrice = false;
+    while (true)
+    {
+        const auto readRes = reader.read();
+        ASSERT_TRUE(readRes);
+        if (!readRes.value())
+            break;
+
+        switch (reader.nodeType())
+        {
+        case cpplibxml2::ReaderNodeType::StartElement:
+            ++startElements;
+            inPrice = reader.name() == "price";
+            if (const auto id = reader.attribute("id"))
+                ids.emplace_back(id.value());
+            break;
+        case cpplibxml2::ReaderNodeType::EndElement:
+            ++endElements;
+            inPrice = false;
+            break;
+        case cpplibxml2::ReaderNodeType::Text:
+            if (inPrice)
+                prices.emplace_back(reader.value());
+            break;
+        default:
+            break;
+        }
+    }
+
+    EXPECT_EQ(startElements, 1 + 12 + 12 * 6);
+    EXPECT_EQ(endElements, startElements);
+    ASSERT_EQ(ids.size(), 12);
+    EXPECT_EQ(ids.front(), "bk101");
+    EXPECT_EQ(ids.back(), "bk112");
+    ASSERT_EQ(prices.size(), 12);
+    EXPECT_EQ(prices.front(), "44.95");
+}
+
+TEST(Reader, AttributeCursor)
+{
+    auto ReaderRes = cpplibxml2::Reader::open(R"(<?xml version="1.0"?><root a="1" b="2"/>)");
+    ASSERT_TRUE(ReaderRes);
+    auto &reader = ReaderRes.value();
+    ASSERT_TRUE(reader.read().value());
+    EXPECT_EQ(reader.nodeType(), cpplibxml2::ReaderNodeType::StartElement);
+    EXPECT_TRUE(reader.isEmptyElement());
+    EXPECT_EQ(reader.attributeCount(), 2);
+
+    std::vector<std::pair<std::string, std::string>> attributes;
+    for (bool ok = reader.moveToFirstAttribute(); ok; ok = reader.moveToNextAttribute())
+        attributes.emplace_back(reader.name(), reader.value());
+    EXPECT_TRUE(reader.moveToElement());
+    EXPECT_EQ(reader.name(), "root");
+    EXPECT_EQ(attributes, (std::vector<std::pair<std::string, std::string>>{{"a", "1"}, {"b", "2"}}));
+    EXPECT_FALSE(reader.attribute("c"));
+}
+
+TEST(Reader, Namespaces)
+{
+    ASSERT_TRUE(std::filesystem::exists(nsExampleFile));
+    auto ReaderRes = cpplibxml2::Reader::openFile(nsExampleFile);
+    ASSERT_TRUE(ReaderRes);
+    auto &reader = ReaderRes.value();
+    ASSERT_TRUE(reader.read().value());
+    EXPECT_EQ(reader.name(), "ns2:ConnectorServices");
+    EXPECT_EQ(reader.localName(), "ConnectorServices");
+    EXPECT_EQ(reader.prefix(), "ns2");
+    EXPECT_EQ(reader.namespaceUri(), "http://ws.gematik.de/conn/ServiceDirectory/v3.1");
+}
+
+TEST(Reader, ExpandAndSkip)
+{
+    ASSERT_TRUE(std::filesystem::exists(exampleFile));
+    auto ReaderRes = cpplibxml2::Reader::openFile(exampleFile);
+    ASSERT_TRUE(ReaderRes);
+    auto &reader = ReaderRes.value();
+
+    std::vector<std::string> titles;
+    auto readRes = reader.read();
+    while (readRes && readRes.value())
+    {
+        if (reader.nodeType() == cpplibxml2::ReaderNodeType::StartElement && reader.name() == "book")
+        {
+            const auto book = reader.expand();
+            ASSERT_TRUE(book);
+            const auto title = book.value().findChild("title");
+            ASSERT_TRUE(title);
+            titles.push_back(title.value().value().value());
+            readRes = reader.next();
+        }
+        else
+        {
+            readRes = reader.read();
+        }
+    }
+    ASSERT_TRUE(readRes);
+    ASSERT_EQ(titles.size(), 12);
+    EXPECT_EQ(titles.front(), "XML Developer's Guide");
+}
+
+TEST(Reader, ExpandDocOutlivesCursor)
+{
+    ASSERT_TRUE(std::filesystem::exists(nsExampleFile));
+    std::vector<cpplibxml2::Doc> records;
+    {
+        auto ReaderRes = cpplibxml2::Reader::openFile(nsExampleFile);
+        ASSERT_TRUE(ReaderRes);
+        auto &reader = ReaderRes.value();
+        auto readRes = reader.read();
+        while (readRes && readRes.value())
+        {
+            if (reader.nodeType() == cpplibxml2::ReaderNodeType::StartElement && reader.localName() == "Service")
+            {
+                auto doc = reader.expandDoc();
+                ASSERT_TRUE(doc);
+                records.push_back(std::move(doc.value()));
+                readRes = reader.next();
+            }
+            else
+            {
+                readRes = reader.read();
+            }
+        }
+        ASSERT_TRUE(readRes);
+    }
+
+    ASSERT_FALSE(records.empty());
+    const auto root = records.front().root();
+    ASSERT_TRUE(root);
+    EXPECT_EQ(root.value().name().value(), "Service");
+    EXPECT_EQ(root.value().getNamespace().second, "http://ws.gematik.de/conn/ServiceInformation/v2.0");
+    const auto name = root.value().findProperty("Name");
+    ASSERT_TRUE(name);
+    EXPECT_EQ(name.value().second, "PHRManagementService");
+    EXPECT_TRUE(root.value().findChild("Abstract", "http://ws.gematik.de/conn/ServiceInformation/v2.0"));
+}
+
+TEST(Reader, MalformedInput)
+{
+    auto ReaderRes = cpplibxml2::Reader::open(R"(<?xml version="1.0"?><root><a></b></root>)",
+                                              cpplibxml2::ParserOptions::NoError | cpplibxml2::ParserOptions::NoWarning);
+    ASSERT_TRUE(ReaderRes);
+    auto &reader = ReaderRes.value();
+    auto readRes = reader.read();
+    while (readRes && readRes.value())
+        readRes = reader.read();
+    ASSERT_FALSE(readRes);
+    EXPECT_STREQ(readRes.error().what(), "Document not read successfully.");
+}
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+
+#include <recordSplitter.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static const std::filesystem::path exampleFile{"testData/example.xml"};
+static const std::filesystem::path nsExampleFile{"testData/nsExample.xml"};
+
+namespace
+{
+constexpr std::string_view serviceNs = "http://ws.gematik.de/conn/ServiceInformation/v2.0";
+
+std::string makeFeed(const int count)
+{
+    std::string xml = R"(<?xml version="1.0"?><feed><header>ignored</header>)";
+    for (int i = 0; i < count; ++i)
+        xml += "<record><id>" + std::to_string(i) + "</id></record>";
+    return xml + "</feed>";
+}
+
+std::size_t recordId(const cpplibxml2::Doc &record)
+{
+    return record.root().value().findChild("id").value().valueAs<std::size_t>().value();
+}
+} // namespace
+
+TEST(RecordSplitter, Next)
+{
+    auto splitter = cpplibxml2::RecordSplitter::openFile(exampleFile, "book").value();
+    std::vector<cpplibxml2::Doc> books;
+    while (true)
+    {
+        auto record = splitter.next();
+        ASSERT_TRUE(record) << record.error().what();
+        if (!record.value())
+            break;
+        books.push_back(std::move(*record.value()));
+    }
+    ASSERT_EQ(books.size(), 12u);
+
+    const auto first = books.front().root().value();
+    EXPECT_EQ(first.name(), "book");
+    EXPECT_EQ(first.attribute("id"), "bk101");
+    EXPECT_EQ(first.findChild("author").value().value(), "Gambardella, Matthew");
+    EXPECT_EQ(books.back().root().value().attribute("id"), "bk112");
+
+    // Stays at the end.
+    EXPECT_FALSE(splitter.next().value());
+}
+
+TEST(RecordSplitter, InvalidArguments)
+{
+    const auto unnamed = cpplibxml2::RecordSplitter::open("<feed/>", "");
+    ASSERT_FALSE(unnamed);
+    EXPECT_STREQ(unnamed.error().what(), "Record name is empty.");
+
+    const auto missing = cpplibxml2::RecordSplitter::openFile("testData/doesNotExist.xml", "record");
+    ASSERT_FALSE(missing);
+    EXPECT_STREQ(missing.error().what(), "Document don't exist.");
+
+    EXPECT_FALSE(cpplibxml2::RecordSplitter::open("", "record"));
+}
+
+TEST(RecordSplitter, Namespaces)
+{
+    auto splitter = cpplibxml2::RecordSplitter::openFile(nsExampleFile, "Service", serviceNs).value();
+    std::vector<std::string> names;
+    const auto count = splitter.forEach([&names](const std::size_t index, cpplibxml2::Doc &&record) {
+        EXPECT_EQ(index, names.size());
+        const auto root = record.root().value();
+        // The namespace is declared on the ancestors in the input and carried over.
+        EXPECT_EQ(root.getNamespace().second, serviceNs);
+        EXPECT_TRUE(root.findChild("Abstract", serviceNs).has_value());
+        names.emplace_back(root.attribute("Name").value());
+    });
+    ASSERT_TRUE(count) << count.error().what();
+    EXPECT_EQ(count.value(), 14u);
+    EXPECT_EQ(names.front(), "PHRManagementService");
+
+    auto otherNamespace = cpplibxml2::RecordSplitter::openFile(nsExampleFile, "Service", "urn:other").value();
+    EXPECT_EQ(otherNamespace.forEach([](std::size_t, cpplibxml2::Doc &&) {}).value(), 0u);
+    auto anyNamespace = cpplibxml2::RecordSplitter::openFile(nsExampleFile, "Service").value();
+    EXPECT_EQ(anyNamespace.forEach([](std::size_t, cpplibxml2::Doc &&) {}).value(), 14u);
+}
+
+TEST(RecordSplitter, NestedRecords)
+{
+    constexpr std::string_view xml =
+        R"(<feed><item n="0"><item n="inner"/></item><group><item n="1"/></group></feed>)";
+    auto splitter = cpplibxml2::RecordSplitter::open(xml, "item").value();
+    std::vector<std::string> ids;
+    ASSERT_EQ(splitter
+                  .forEach([&ids](std::size_t, cpplibxml2::Doc &&record) {
+                      ids.emplace_back(record.root().value().attribute("n").value());
+                  })
+                  .value(),
+              2u);
+    EXPECT_EQ(ids, (std::vector<std::string>{"0", "1"}));
+}
+
+TEST(RecordSplitter, MalformedInput)
+{
+    constexpr std::string_view xml = "<feed><record><id>0</id></record><record><id>1</id></record><broken></feed>";
+    auto splitter = cpplibxml2::RecordSplitter::open(xml, "record", {}, cpplibxml2::ParserOptions::NoError).value();
+    std::vector<std::size_t> ids;
+    const auto count =
+        splitter.forEach([&ids](std::size_t, cpplibxml2::Doc &&record) { ids.push_back(recordId(record)); });
+    ASSERT_FALSE(count);
+    EXPECT_STREQ(count.error().what(), "Document not read successfully.");
+    // The parser works ahead, so records just before the error may be missing.
+    for (std::size_t i = 0; i < ids.size(); ++i)
+        EXPECT_EQ(ids[i], i);
+}
+
+class RecordSplitterParallel : public testing::TestWithParam<std::size_t>
+{
+};
+
+TEST_P(RecordSplitterParallel, Unordered)
+{
+    const auto xml = makeFeed(500);
+    auto splitter = cpplibxml2::RecordSplitter::open(xml, "record").value();
+    std::mutex mutex;
+    std::set<std::size_t> seen;
+    const auto count = splitter.forEach(
+        [&](const std::size_t index, cpplibxml2::Doc &&record) {
+            const auto id = recordId(record);
+            EXPECT_EQ(id, index);
+            const std::lock_guard lock{mutex};
+            seen.insert(id);
+        },
+        GetParam(), cpplibxml2::RecordOrder::Unordered);
+    ASSERT_TRUE(count) << count.error().what();
+    EXPECT_EQ(count.value(), 500u);
+    EXPECT_EQ(seen.size(), 500u);
+}
+
+TEST_P(RecordSplitterParallel, Ordered)
+{
+    const auto xml = makeFeed(500);
+    auto splitter = cpplibxml2::RecordSplitter::open(xml, "record").value();
+    std::vector<std::size_t> ids;
+    const auto count = splitter.forEach(
+        [&ids](std::size_t, cpplibxml2::Doc &&record) { ids.push_back(recordId(record)); }, GetParam(),
+        cpplibxml2::RecordOrder::Ordered);
+    ASSERT_TRUE(count) << count.error().what();
+    ASSERT_EQ(ids.size(), 500u);
+    for (std::size_t i = 0; i < ids.size(); ++i)
+        ASSERT_EQ(ids[i], i);
+}
+
+TEST_P(RecordSplitterParallel, Transform)
+{
+    const auto xml = makeFeed(300);
+    auto splitter = cpplibxml2::RecordSplitter::open(xml, "record").value();
+    // Skip one record with the pull API first; the parallel part continues from there.
+    ASSERT_TRUE(splitter.next().value());
+
+    std::vector<std::pair<std::size_t, std::string>> results;
+    const auto count = splitter.transform(
+        GetParam(), cpplibxml2::RecordOrder::Ordered,
+        [](std::size_t, cpplibxml2::Doc &&record) { return record.dump().value(); },
+        [&results](const std::size_t index, std::string &&dumped) { results.emplace_back(index, std::move(dumped)); });
+    ASSERT_TRUE(count) << count.error().what();
+    ASSERT_EQ(count.value(), 299u);
+    ASSERT_EQ(results.size(), 299u);
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        EXPECT_EQ(results[i].first, i + 1);
+        EXPECT_NE(results[i].second.find("<id>" + std::to_string(i + 1) + "</id>"), std::string::npos);
+    }
+}
+
+TEST_P(RecordSplitterParallel, ExceptionStopsSplit)
+{
+    const auto xml = makeFeed(1000);
+    auto splitter = cpplibxml2::RecordSplitter::open(xml, "record").value();
+    std::atomic<std::size_t> calls{0};
+    EXPECT_THROW(
+        std::ignore = splitter.forEach(
+            [&calls](std::size_t index, cpplibxml2::Doc &&) {
+                ++calls;
+                if (index == 10)
+                    throw std::runtime_error{"stop"};
+            },
+            GetParam(), cpplibxml2::RecordOrder::Unordered),
+        std::runtime_error);
+    // Only the records read ahead are processed after the failure.
+    EXPECT_LT(calls.load(), 1000u);
+}
+
+TEST_P(RecordSplitterParallel, MalformedInput)
+{
+    auto xml = makeFeed(100);
+    xml.insert(xml.rfind("</feed>"), "<broken>");
+    auto splitter = cpplibxml2::RecordSplitter::open(xml, "record", {}, cpplibxml2::ParserOptions::NoError).value();
+    std::vector<std::size_t> ids;
+    const auto count = splitter.forEach(
+        [&ids](std::size_t, cpplibxml2::Doc &&record) { ids.push_back(recordId(record)); }, GetParam(),
+        cpplibxml2::RecordOrder::Ordered);
+    ASSERT_FALSE(count);
+    // Everything up to shortly before the error was delivered, in order.
+    EXPECT_GT(ids.size(), 50u);
+    for (std::size_t i = 0; i < ids.size(); ++i)
+        EXPECT_EQ(ids[i], i);
+}
+
+INSTANTIATE_TEST_SUITE_P(Threads, RecordSplitterParallel, testing::Values(1, 4));
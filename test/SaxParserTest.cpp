@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+
+#include <saxParser.hpp>
+
+#include <string>
+#include <vector>
+
+static const std::filesystem::path exampleFile{"testData/example.xml"};
+static const std::filesystem::path nsExampleFile{"testData/nsExample.xml"};
+
+namespace
+{
+struct CountingHandler
+{
+    std::size_t documents = 0;
+    std::size_t startElements = 0;
+    std::size_t endElements = 0;
+    std::vector<std::string> ids;
+    std::string text;
+
+    void onStartDocument()
+    {
+        ++documents;
+    }
+
+    void onStartElement(std::string_view, std::string_view, std::string_view, std::span<const cpplibxml2::SaxNamespace>,
+                        std::span<const cpplibxml2::SaxAttribute> attributes)
+    {
+        ++startElements;
+        for (const auto &attribute : attributes)
+        {
+            if (attribute.localName == "id")
+                ids.emplace_back(attribute.value);
+        }
+    }
+
+    void onEndElement(std::string_view, std::string_view, std::string_view)
+    {
+        ++endElements;
+    }
+
+    void onCharacters(const std::string_view chars)
+    {
+        text += chars;
+    }
+};
+
+struct TextOnlyHandler
+{
+    std::string text;
+
+    void onCharacters(const std::string_view chars)
+    {
+        text += chars;
+    }
+};
+
+struct NoCallbacks
+{
+};
+
+struct NamespaceHandler
+{
+    std::vector<std::pair<std::string, std::string>> declared;
+    std::vector<std::string> serviceNames;
+
+    void onStartElement(const std::string_view localName, std::string_view, const std::string_view uri,
+                        const std::span<const cpplibxml2::SaxNamespace> namespaces,
+                        const std::span<const cpplibxml2::SaxAttribute> attributes)
+    {
+        for (const auto &ns : namespaces)
+            declared.emplace_back(ns.prefix, ns.uri);
+        if (localName == "Service" && uri == "http://ws.gematik.de/conn/ServiceInformation/v2.0")
+        {
+            for (const auto &attribute : attributes)
+            {
+                if (attribute.localName == "Name")
+                    serviceNames.emplace_back(attribute.value);
+            }
+        }
+    }
+};
+
+struct MiscHandler
+{
+    std::vector<std::string> events;
+
+    void onComment(const std::string_view text)
+    {
+        events.push_back("comment:" + std::string{text});
+    }
+
+    void onCData(const std::string_view text)
+    {
+        events.push_back("cdata:" + std::string{text});
+    }
+
+    void onProcessingInstruction(const std::string_view target, const std::string_view data)
+    {
+        events.push_back("pi:" + std::string{target} + "=" + std::string{data});
+    }
+
+    void onEndDocument()
+    {
+        events.emplace_back("end");
+    }
+};
+} // namespace
+
+TEST(SaxParser, ParseFile)
+{
+    ASSERT_TRUE(std::filesystem::exists(exampleFile));
+    CountingHandler handler;
+    const auto result = cpplibxml2::SaxParser<CountingHandler>::parseFile(exampleFile, handler);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(handler.documents, 1);
+    EXPECT_EQ(handler.startElements, 1 + 12 + 12 * 6);
+    EXPECT_EQ(handler.endElements, handler.startElements);
+    ASSERT_EQ(handler.ids.size(), 12);
+    EXPECT_EQ(handler.ids.front(), "bk101");
+    EXPECT_NE(handler.text.find("Midnight Rain"), std::string::npos);
+}
+
+TEST(SaxParser, ParseFileMissing)
+{
+    NoCallbacks handler;
+    const auto result = cpplibxml2::SaxParser<NoCallbacks>::parseFile("testData/doesNotExist.xml", handler);
+    ASSERT_FALSE(result);
+    EXPECT_STREQ(result.error().what(), "Document don't exist.");
+}
+
+TEST(SaxParser, OnlyDefinedCallbacksAreUsed)
+{
+    TextOnlyHandler handler;
+    ASSERT_TRUE(cpplibxml2::SaxParser<TextOnlyHandler>::parse(
+        R"(<?xml version="1.0"?><root a="1"><b>Hello</b> <c>World</c></root>)", handler));
+    EXPECT_EQ(handler.text, "Hello World");
+
+    NoCallbacks nothing;
+    EXPECT_TRUE(cpplibxml2::SaxParser<NoCallbacks>::parse(R"(<?xml version="1.0"?><root/>)", nothing));
+}
+
+TEST(SaxParser, AttributeValuesAreExact)
+{
+    CountingHandler handler;
+    ASSERT_TRUE(cpplibxml2::SaxParser<CountingHandler>::parse(
+        R"(<?xml version="1.0"?><root><a id="first" other="x"/><b other="y" id="second"/></root>)", handler));
+    EXPECT_EQ(handler.ids, (std::vector<std::string>{"first", "second"}));
+}
+
+TEST(SaxParser, EntitiesAreSubstituted)
+{
+    TextOnlyHandler handler;
+    ASSERT_TRUE(cpplibxml2::SaxParser<TextOnlyHandler>::parse(
+        R"(<?xml version="1.0"?><!DOCTYPE root [<!ENTITY who "World">]><root>Hello &who; &amp; more</root>)",
+        handler));
+    EXPECT_EQ(handler.text, "Hello World & more");
+}
+
+TEST(SaxParser, Namespaces)
+{
+    ASSERT_TRUE(std::filesystem::exists(nsExampleFile));
+    NamespaceHandler handler;
+    ASSERT_TRUE(cpplibxml2::SaxParser<NamespaceHandler>::parseFile(nsExampleFile, handler));
+    EXPECT_EQ(handler.declared.size(), 3);
+    EXPECT_NE(std::ranges::find(handler.declared,
+                                std::pair<std::string, std::string>{"ns2",
+                                                                    "http://ws.gematik.de/conn/ServiceDirectory/v3.1"}),
+              handler.declared.end());
+    ASSERT_FALSE(handler.serviceNames.empty());
+    EXPECT_EQ(handler.serviceNames.front(), "PHRManagementService");
+}
+
+TEST(SaxParser, CommentsCDataAndProcessingInstructions)
+{
+    MiscHandler handler;
+    ASSERT_TRUE(cpplibxml2::SaxParser<MiscHandler>::parse(
+        R"(<?xml version="1.0"?><root><!--note--><![CDATA[<raw>]]><?target data?></root>)", handler));
+    EXPECT_EQ(handler.events,
+              (std::vector<std::string>{"comment:note", "cdata:<raw>", "pi:target=data", "end"}));
+}
+
+TEST(SaxParser, MalformedInput)
+{
+    CountingHandler handler;
+    const auto result = cpplibxml2::SaxParser<CountingHandler>::parse(
+        R"(<?xml version="1.0"?><root><a></b></root>)", handler,
+        cpplibxml2::ParserOptions::NoError | cpplibxml2::ParserOptions::NoWarning);
+    ASSERT_FALSE(result);
+    EXPECT_STREQ(result.error().what(), "Document not parsed successfully.");
+
+    CountingHandler recovering;
+    EXPECT_TRUE(cpplibxml2::SaxParser<CountingHandler>::parse(R"(<?xml version="1.0"?><root><a></b></root>)",
+                                                             recovering,
+                                                             cpplibxml2::ParserOptions::Recover |
+                                                                 cpplibxml2::ParserOptions::NoError));
+    EXPECT_GE(recovering.startElements, 2);
+}
+
+TEST(SaxParser, EmptyInput)
+{
+    NoCallbacks handler;
+    const auto result = cpplibxml2::SaxParser<NoCallbacks>::parse("", handler);
+    ASSERT_FALSE(result);
+    EXPECT_STREQ(result.error().what(), "Document is empty.");
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <cpplibxml2.hpp>
+#include <outputSink.hpp>
+#include <parallelParser.hpp>
+#include <parser.hpp>
+#include <stats.hpp>
+
+#include <numeric>
+#include <string>
+#include <thread>
+
+#ifdef CPPLIBXML2_ENABLE_STATS
+
+namespace
+{
+constexpr std::string_view catalog =
+    R"(<?xml version="1.0"?><catalog><book id="1"><title>One</title></book><book id="2"><title>Two</title></book></catalog>)";
+
+std::uint64_t bucketSum(const cpplibxml2::DurationHistogram &histogram)
+{
+    return std::accumulate(histogram.buckets.begin(), histogram.buckets.end(), std::uint64_t{0});
+}
+} // namespace
+
+TEST(Stats, Parse)
+{
+    cpplibxml2::resetStats();
+    ASSERT_TRUE(cpplibxml2::Doc::parse(catalog));
+    ASSERT_FALSE(cpplibxml2::Doc::parse("<broken>", cpplibxml2::ParserOptions::NoError));
+    ASSERT_FALSE(cpplibxml2::Doc::parse(""));
+    ASSERT_TRUE(cpplibxml2::Parser::local().parse(catalog));
+    ASSERT_TRUE(cpplibxml2::Doc::parseFile("testData/example.xml"));
+
+    const auto stats = cpplibxml2::statsSnapshot();
+    EXPECT_EQ(stats.parseCalls, 5u);
+    EXPECT_EQ(stats.parseFailures, 2u);
+    EXPECT_EQ(stats.bytesParsed,
+              2 * catalog.size() + std::string_view{"<broken>"}.size() +
+                  std::filesystem::file_size("testData/example.xml"));
+    EXPECT_EQ(stats.parseTime.count, 5u);
+    EXPECT_EQ(bucketSum(stats.parseTime), 5u);
+    EXPECT_GT(stats.parseTime.totalNanoseconds, 0u);
+}
+
+TEST(Stats, Traversal)
+{
+    const auto doc = cpplibxml2::Doc::parse(catalog).value();
+    cpplibxml2::resetStats();
+
+    const auto root = doc.root().value();
+    const auto books = root.getChildren().value();
+    const auto title = books[1].findChild("title").value();
+    EXPECT_EQ(title.value().value(), "Two");
+    std::string buffer;
+    EXPECT_EQ(books[0].valueView(buffer).value(), "One");
+
+    const auto stats = cpplibxml2::statsSnapshot();
+    // root, two books, title
+    EXPECT_EQ(stats.nodeHandles, 4u);
+    // two catalog children, the title of the second book, title and text of the first book
+    EXPECT_EQ(stats.nodesVisited, 5u);
+    // value() copies the contiguous title text, valueView() concatenates the first book into the buffer
+    EXPECT_EQ(stats.valueCopies, 2u);
+    EXPECT_EQ(stats.valueBytesCopied, 6u);
+}
+
+TEST(Stats, AttributesAndRanges)
+{
+    const auto doc = cpplibxml2::Doc::parse(
+                         R"(<catalog><book id="1" lang="en"/><!-- c --><book id="2"><title>T</title></book></catalog>)")
+                         .value();
+    const auto root = doc.root().value();
+    const auto book = root.findChild("book").value();
+    cpplibxml2::resetStats();
+
+    EXPECT_EQ(book.attribute("lang"), "en");
+    EXPECT_TRUE(book.findProperty("id"));
+    EXPECT_EQ(book.getProperties().size(), 2u);
+    EXPECT_EQ(cpplibxml2::AttributeIndex{book}.find("id"), "1");
+    // lang after id, id, both attributes twice
+    EXPECT_EQ(cpplibxml2::statsSnapshot().nodesVisited, 7u);
+
+    cpplibxml2::resetStats();
+    EXPECT_EQ(std::ranges::distance(root.elements()), 2);
+    EXPECT_EQ(std::ranges::distance(root.descendants()), 3);
+    // book, comment, book, then book, comment, book, title and its text
+    EXPECT_EQ(cpplibxml2::statsSnapshot().nodesVisited, 8u);
+}
+
+TEST(Stats, Serialize)
+{
+    const auto doc = cpplibxml2::Doc::parse(catalog).value();
+    cpplibxml2::resetStats();
+
+    const auto dumped = doc.dump().value();
+    std::string streamed;
+    ASSERT_TRUE(doc.serialize(cpplibxml2::OutputSink{[&streamed](const std::string_view chunk) {
+        streamed += chunk;
+        return true;
+    }}));
+
+    const auto stats = cpplibxml2::statsSnapshot();
+    EXPECT_EQ(stats.serializeCalls, 2u);
+    EXPECT_EQ(stats.serializedBytes, dumped.size() + streamed.size());
+    EXPECT_EQ(stats.serializeTime.count, 2u);
+}
+
+TEST(Stats, ParallelParserCountsOnce)
+{
+    std::string xml = "<feed>";
+    for (int i = 0; i < 400; ++i)
+        xml.append("<item><name>").append(std::to_string(i)).append("</name></item>");
+    xml.append("</feed>");
+    cpplibxml2::ParallelParser parser{4};
+    parser.setMinChunkSize(512);
+
+    cpplibxml2::resetStats();
+    ASSERT_TRUE(parser.parse(xml, "item"));
+    ASSERT_GT(cpplibxml2::detail::lastChunkCount(), 1u);
+    // IDs are only found once the chunks are parsed; the split then hands over to Doc::parse.
+    const auto withIds = std::string{xml}.replace(xml.rfind("<item>"), 6, "<item xml:id=\"last\">");
+    ASSERT_TRUE(parser.parse(withIds, "item"));
+    ASSERT_EQ(cpplibxml2::detail::lastChunkCount(), 0u);
+
+    const auto stats = cpplibxml2::statsSnapshot();
+    EXPECT_EQ(stats.parseCalls, 2u);
+    EXPECT_EQ(stats.parseTime.count, 2u);
+    EXPECT_EQ(stats.bytesParsed, xml.size() + withIds.size());
+}
+
+TEST(Stats, CountsOtherThreads)
+{
+    cpplibxml2::resetStats();
+    {
+        std::jthread worker{[] {
+            for (int i = 0; i < 10; ++i)
+                EXPECT_TRUE(cpplibxml2::Doc::parse(catalog));
+        }};
+        // Counted while the thread is alive and after it exited.
+    }
+    EXPECT_EQ(cpplibxml2::statsSnapshot().parseCalls, 10u);
+
+    cpplibxml2::resetStats();
+    EXPECT_EQ(cpplibxml2::statsSnapshot().parseCalls, 0u);
+}
+
+#else
+
+TEST(Stats, Disabled)
+{
+    static_assert(!cpplibxml2::statsEnabled);
+    ASSERT_TRUE(cpplibxml2::Doc::parse("<a/>"));
+    EXPECT_EQ(cpplibxml2::statsSnapshot().parseCalls, 0u);
+    GTEST_SKIP() << "Built without CPPLIBXML2_ENABLE_STATS";
+}
+
+#endif
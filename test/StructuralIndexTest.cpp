@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <cpplibxml2.hpp>
+#include <structuralIndex.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using cpplibxml2::SimdLevel;
+using cpplibxml2::StructuralIndex;
+
+namespace
+{
+std::string readFile(const std::filesystem::path &path)
+{
+    std::ifstream in{path, std::ios::binary};
+    std::ostringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+
+struct ParsedElement
+{
+    std::string localName;
+    std::size_t depth;
+};
+
+void collect(const cpplibxml2::Node &node, const std::size_t depth, std::vector<ParsedElement> &out)
+{
+    out.push_back({std::string{node.name().value()}, depth});
+    for (const auto &child : node.elements())
+        collect(child, depth + 1, out);
+}
+
+std::string_view localName(const std::string_view qualified)
+{
+    const auto colon = qualified.find(':');
+    return colon == std::string_view::npos ? qualified : qualified.substr(colon + 1);
+}
+} // namespace
+
+class StructuralIndexTest : public testing::TestWithParam<SimdLevel>
+{
+};
+
+TEST_P(StructuralIndexTest, AgreesWithLibxml2)
+{
+    for (const auto *file : {"testData/example.xml", "testData/nsExample.xml"})
+    {
+        SCOPED_TRACE(file);
+        const auto input = readFile(file);
+        const auto index = StructuralIndex::build(input, GetParam());
+        ASSERT_TRUE(index) << index.error().what();
+        EXPECT_LE(index->level(), GetParam());
+
+        std::vector<ParsedElement> parsed;
+        collect(cpplibxml2::Doc::parse(input).value().root().value(), 0, parsed);
+        const auto elements = index->elements();
+        ASSERT_EQ(elements.size(), parsed.size());
+        for (std::size_t i = 0; i < parsed.size(); ++i)
+        {
+            EXPECT_EQ(localName(elements[i].name), parsed[i].localName);
+            EXPECT_EQ(elements[i].depth, parsed[i].depth);
+            EXPECT_EQ(input[elements[i].begin], '<');
+            EXPECT_EQ(input[elements[i].end - 1], '>');
+        }
+        EXPECT_EQ(elements.front().end, input.find_last_of('>') + 1);
+    }
+}
+
+TEST_P(StructuralIndexTest, RecordsParseOnTheirOwn)
+{
+    const auto input = readFile("testData/example.xml");
+    const auto index = StructuralIndex::build(input, GetParam()).value();
+    const auto books = index.records("book");
+    ASSERT_EQ(books.size(), 12u);
+    const auto last = cpplibxml2::Doc::parse(books.back().text(input)).value();
+    EXPECT_EQ(last.root().value().attribute("id"), "bk112");
+    EXPECT_EQ(last.root().value().findChild("price").value().valueAs<double>().value(), 49.95);
+}
+
+TEST_P(StructuralIndexTest, StructuralsMatchScalarScan)
+{
+    // Lengths around the 16 and 64 byte blocks, with structurals at both block edges.
+    for (std::size_t length = 0; length < 200; ++length)
+    {
+        std::string text(length, 'x');
+        for (std::size_t i = 0; i < length; i += 5)
+            text[i] = ">\"'"[i % 3];
+        const auto input = "<r>" + text + "</r>";
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < input.size(); ++i)
+            if (std::string_view{"<>\"'"}.contains(input[i]))
+                expected.push_back(i);
+
+        const auto index = StructuralIndex::build(input, GetParam());
+        ASSERT_TRUE(index) << index.error().what();
+        EXPECT_TRUE(std::ranges::equal(index->structurals(), expected)) << length;
+        EXPECT_EQ(index->elements().size(), 1u);
+    }
+
+    const std::string large = readFile("testData/nsExample.xml");
+    const auto scalar = StructuralIndex::build(large, SimdLevel::Scalar).value();
+    const auto simd = StructuralIndex::build(large, GetParam()).value();
+    EXPECT_TRUE(std::ranges::equal(scalar.structurals(), simd.structurals()));
+}
+
+TEST_P(StructuralIndexTest, SkipsMarkupThatIsNoTag)
+{
+    const std::string input = R"(<?xml version="1.0"?>
+<!DOCTYPE feed [
+  <!ENTITY e "<item>">
+  <!-- don't <item> -->
+]>
+<feed>
+  <!-- <item id="comment"> it's -->
+  <item a="1 > 0" b='say "hi"' c="/>"><![CDATA[<item> ]]></item>
+  <?pi <item> '?>
+  <item/>
+  <group><item><item/></item></group>
+  text with > and " and '
+</feed>
+<!-- epilog <item> -->)";
+    const auto index = StructuralIndex::build(input, GetParam());
+    ASSERT_TRUE(index) << index.error().what();
+    std::vector<std::string_view> names;
+    for (const auto &element : index->elements())
+        names.push_back(element.name);
+    EXPECT_EQ(names, (std::vector<std::string_view>{"feed", "item", "item", "group", "item", "item"}));
+
+    const auto records = index->records("item");
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_TRUE(records[0].text(input).starts_with(R"(<item a="1 > 0")"));
+    EXPECT_TRUE(records[0].text(input).ends_with("]]></item>"));
+    EXPECT_EQ(records[1].text(input), "<item/>");
+    EXPECT_EQ(records[2].text(input), "<item><item/></item>");
+    EXPECT_EQ(records[2].depth, 2u);
+}
+
+TEST_P(StructuralIndexTest, MalformedMarkup)
+{
+    for (const auto *input : {"<a><!-- open</a>", "<a><![CDATA[x</a>", "<a><?pi</a>", "<a b=\"1></a>", "<a><b></a>",
+                              "<a>", "</a>", "<a><b></b>", "<!DOCTYPE a [<a/>"})
+    {
+        const auto index = StructuralIndex::build(input, GetParam());
+        EXPECT_FALSE(index) << input;
+    }
+    EXPECT_STREQ(StructuralIndex::build("<a><b></a>", GetParam()).error().what(), "Mismatched end tag.");
+    EXPECT_STREQ(StructuralIndex::build("<a>", GetParam()).error().what(), "Unterminated markup.");
+    EXPECT_TRUE(StructuralIndex::build("", GetParam())->elements().empty());
+}
+
+INSTANTIATE_TEST_SUITE_P(Levels, StructuralIndexTest,
+                         testing::Values(SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2));
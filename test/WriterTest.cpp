@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <reader.hpp>
+#include <writer.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+cpplibxml2::Writer toStream(std::ostringstream &stream, const bool addWhiteSpaces = false)
+{
+    auto writer = cpplibxml2::Writer::toSink(stream, addWhiteSpaces);
+    EXPECT_TRUE(writer.has_value());
+    return std::move(writer.value());
+}
+} // namespace
+
+TEST(Writer, ElementsAttributesAndText)
+{
+    std::ostringstream stream;
+    auto writer = toStream(stream);
+    ASSERT_TRUE(writer.startDocument().has_value());
+    ASSERT_TRUE(writer.startElement("catalog").has_value());
+    ASSERT_TRUE(writer.attribute("version", "1 & 2").has_value());
+    ASSERT_TRUE(writer.element("title", "a < b").has_value());
+    ASSERT_TRUE(writer.startElement("note").has_value());
+    ASSERT_TRUE(writer.text("plain ").has_value());
+    ASSERT_TRUE(writer.cdata("<raw>").has_value());
+    ASSERT_TRUE(writer.endElement().has_value());
+    ASSERT_TRUE(writer.comment(" done ").has_value());
+    ASSERT_TRUE(writer.finish().has_value());
+
+    EXPECT_EQ(stream.str(), "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                            "<catalog version=\"1 &amp; 2\"><title>a &lt; b</title>"
+                            "<note>plain <![CDATA[<raw>]]></note><!-- done --></catalog>\n");
+}
+
+TEST(Writer, MatchesDocDump)
+{
+    std::ostringstream stream;
+    auto writer = toStream(stream, true);
+    ASSERT_TRUE(writer.startDocument().has_value());
+    ASSERT_TRUE(writer.startElement("root").has_value());
+    ASSERT_TRUE(writer.startElement("a").has_value());
+    ASSERT_TRUE(writer.attribute("x", "1").has_value());
+    ASSERT_TRUE(writer.element("b", "text").has_value());
+    ASSERT_TRUE(writer.finish().has_value());
+
+    const auto doc = cpplibxml2::Doc::parse(stream.str()).value();
+    EXPECT_EQ(stream.str(), doc.dump(true).value());
+}
+
+TEST(Writer, Namespaces)
+{
+    std::ostringstream stream;
+    auto writer = toStream(stream);
+    ASSERT_TRUE(writer.startElement("", "feed", "urn:feed").has_value());
+    ASSERT_TRUE(writer.addNamespace("m", "urn:meta").has_value());
+    ASSERT_TRUE(writer.attribute("m", "id", "", "7").has_value());
+    ASSERT_TRUE(writer.startElement("x", "entry", "urn:x").has_value());
+    ASSERT_TRUE(writer.attribute("y", "kind", "urn:y", "z").has_value());
+    ASSERT_TRUE(writer.finish().has_value());
+
+    EXPECT_EQ(stream.str(), R"(<feed xmlns:m="urn:meta" m:id="7" xmlns="urn:feed">)"
+                            R"(<x:entry y:kind="z" xmlns:y="urn:y" xmlns:x="urn:x"/></feed>)");
+
+    const auto doc = cpplibxml2::Doc::parse(stream.str()).value();
+    const auto entry = doc.root().value().findChild("entry").value();
+    EXPECT_EQ(entry.attribute("kind", "urn:y"), "z");
+    EXPECT_EQ(doc.root().value().attribute("id", "urn:meta"), "7");
+}
+
+TEST(Writer, ToFileStreamsLargeOutput)
+{
+    const auto path = std::filesystem::temp_directory_path() / "cpplibxml2_writer.xml";
+    {
+        auto writer = cpplibxml2::Writer::toFile(path);
+        ASSERT_TRUE(writer.has_value());
+        ASSERT_TRUE(writer->startDocument().has_value());
+        ASSERT_TRUE(writer->startElement("records").has_value());
+        for (int i = 0; i < 10000; ++i)
+        {
+            ASSERT_TRUE(writer->startElement("record").has_value());
+            ASSERT_TRUE(writer->attribute("id", std::to_string(i)).has_value());
+            ASSERT_TRUE(writer->element("value", std::to_string(i * 2)).has_value());
+            ASSERT_TRUE(writer->endElement().has_value());
+        }
+        ASSERT_TRUE(writer->finish().has_value());
+    }
+
+    auto reader = cpplibxml2::Reader::openFile(path);
+    ASSERT_TRUE(reader.has_value());
+    int records = 0;
+    while (reader->read().value())
+    {
+        if (reader->nodeType() == cpplibxml2::ReaderNodeType::StartElement && reader->name() == "record")
+            ++records;
+    }
+    EXPECT_EQ(records, 10000);
+    std::filesystem::remove(path);
+}
+
+TEST(Writer, FinishClosesWriter)
+{
+    std::ostringstream stream;
+    auto writer = toStream(stream);
+    ASSERT_TRUE(writer.startElement("a").has_value());
+    ASSERT_TRUE(writer.finish().has_value());
+    EXPECT_EQ(stream.str(), "<a/>");
+
+    const auto result = writer.startElement("b");
+    ASSERT_FALSE(result.has_value());
+    EXPECT_STREQ(result.error().what(), "Writer is closed.");
+}
+
+TEST(Writer, UnbalancedEndElement)
+{
+    std::ostringstream stream;
+    auto writer = toStream(stream);
+    const auto result = writer.endElement();
+    ASSERT_FALSE(result.has_value());
+    EXPECT_STREQ(result.error().what(), "Failed to write XML.");
+}
+
+TEST(Writer, SinkExceptionIsRethrown)
+{
+    auto writer = cpplibxml2::Writer::toSink(
+        cpplibxml2::OutputSink{[](std::string_view) -> bool { throw std::runtime_error{"disk full"}; }});
+    ASSERT_TRUE(writer.has_value());
+    ASSERT_TRUE(writer->startElement("a").has_value());
+    EXPECT_THROW((void)writer->finish(), std::runtime_error);
+}
+
+TEST(Writer, OpenFileFails)
+{
+    const auto writer = cpplibxml2::Writer::toFile("does/not/exist/out.xml");
+    ASSERT_FALSE(writer.has_value());
+    EXPECT_STREQ(writer.error().what(), "Failed to open file for writing.");
+}
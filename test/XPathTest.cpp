@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+
+#include <xpath.hpp>
+
+#include <algorithm>
+#include <ranges>
+#include <string>
+#include <vector>
+
+static const std::filesystem::path exampleFile{"testData/example.xml"};
+static const std::filesystem::path nsExampleFile{"testData/nsExample.xml"};
+
+TEST(XPath, CompileInvalidExpression)
+{
+    const auto expression = cpplibxml2::XPathExpression::compile("//book[");
+    ASSERT_FALSE(expression);
+    EXPECT_STREQ(expression.error().what(), "Invalid XPath expression.");
+}
+
+TEST(XPath, EvaluateNodeSet)
+{
+    const auto doc = cpplibxml2::Doc::parseFile(exampleFile);
+    ASSERT_TRUE(doc);
+    auto context = cpplibxml2::XPathContext::create(doc.value());
+    ASSERT_TRUE(context);
+    const auto expression = cpplibxml2::XPathExpression::compile("/catalog/book[price > 30]/@id/..");
+    ASSERT_TRUE(expression);
+
+    const auto result = context.value().evaluate(expression.value());
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.value().type(), cpplibxml2::XPathResultType::NodeSet);
+    ASSERT_EQ(result.value().size(), 4u);
+    std::vector<std::string> ids;
+    for (const auto book : result.value())
+        ids.emplace_back(book.attribute("id").value());
+    EXPECT_EQ(ids, (std::vector<std::string>{"bk101", "bk110", "bk111", "bk112"}));
+}
+
+TEST(XPath, EvaluateScalars)
+{
+    const auto doc = cpplibxml2::Doc::parseFile(exampleFile);
+    ASSERT_TRUE(doc);
+    auto context = cpplibxml2::XPathContext::create(doc.value());
+    ASSERT_TRUE(context);
+
+    const auto count = context.value().evaluate("count(//book)");
+    ASSERT_TRUE(count);
+    EXPECT_EQ(count.value().type(), cpplibxml2::XPathResultType::Number);
+    EXPECT_DOUBLE_EQ(count.value().number(), 12.0);
+    EXPECT_TRUE(count.value().empty());
+
+    const auto title = context.value().evaluate("string(/catalog/book[1]/title)");
+    ASSERT_TRUE(title);
+    EXPECT_EQ(title.value().string(), "XML Developer's Guide");
+
+    const auto exists = context.value().evaluate("boolean(//book[@id='bk105'])");
+    ASSERT_TRUE(exists);
+    EXPECT_TRUE(exists.value().boolean());
+}
+
+TEST(XPath, EvaluateRelativeToNode)
+{
+    const auto doc = cpplibxml2::Doc::parseFile(exampleFile);
+    ASSERT_TRUE(doc);
+    auto context = cpplibxml2::XPathContext::create(doc.value());
+    ASSERT_TRUE(context);
+    const auto expression = cpplibxml2::XPathExpression::compile("string(author)");
+    ASSERT_TRUE(expression);
+
+    const auto books = doc.value().root().value().elements();
+    const auto second = *std::ranges::next(books.begin());
+    const auto author = context.value().evaluate(expression.value(), second);
+    ASSERT_TRUE(author);
+    EXPECT_EQ(author.value().string(), "Ralls, Kim");
+
+    const auto other = cpplibxml2::Doc::parse(R"(<?xml version="1.0"?><root/>)");
+    ASSERT_TRUE(other);
+    const auto foreign = context.value().evaluate(expression.value(), other.value().root().value());
+    ASSERT_FALSE(foreign);
+    EXPECT_STREQ(foreign.error().what(), "Node belongs to another document.");
+}
+
+TEST(XPath, ReuseAcrossDocuments)
+{
+    const auto expression = cpplibxml2::XPathExpression::compile("sum(/order/line/@amount)");
+    ASSERT_TRUE(expression);
+    const auto first = cpplibxml2::Doc::parse(R"(<?xml version="1.0"?><order><line amount="1"/></order>)");
+    ASSERT_TRUE(first);
+    auto context = cpplibxml2::XPathContext::create(first.value());
+    ASSERT_TRUE(context);
+
+    for (int i = 1; i <= 10; ++i)
+    {
+        std::string xml = R"(<?xml version="1.0"?><order>)";
+        for (int line = 0; line < i; ++line)
+            xml += R"(<line amount="2"/>)";
+        xml += "</order>";
+        const auto doc = cpplibxml2::Doc::parse(xml);
+        ASSERT_TRUE(doc);
+        context.value().setDocument(doc.value());
+        const auto sum = context.value().evaluate(expression.value());
+        ASSERT_TRUE(sum);
+        EXPECT_DOUBLE_EQ(sum.value().number(), 2.0 * i);
+    }
+}
+
+TEST(XPath, RegisterNamespaces)
+{
+    const auto doc = cpplibxml2::Doc::parseFile(nsExampleFile);
+    ASSERT_TRUE(doc);
+    auto context = cpplibxml2::XPathContext::create(doc.value());
+    ASSERT_TRUE(context);
+
+    // Unbound prefixes are an evaluation error.
+    EXPECT_FALSE(context.value().evaluate("//s:Service"));
+
+    const std::vector<std::pair<std::string_view, std::string_view>> namespaces{
+        {"s", "http://ws.gematik.de/conn/ServiceInformation/v2.0"},
+        {"p", "http://ws.gematik.de/int/version/ProductInformation/v1.1"}};
+    ASSERT_TRUE(context.value().registerNamespaces(namespaces));
+    const auto services = context.value().evaluate("//s:Service");
+    ASSERT_TRUE(services);
+    EXPECT_FALSE(services.value().empty());
+    EXPECT_EQ(services.value().begin().operator*().attribute("Name"), "PHRManagementService");
+
+    // Elements in the default namespace are only reachable through a registered prefix.
+    const auto product = context.value().evaluate("string(//p:ProductType)");
+    ASSERT_TRUE(product);
+    EXPECT_EQ(product.value().string(), "Konnektor");
+
+    EXPECT_FALSE(context.value().registerNamespace("", "urn:x"));
+}
+
+TEST(XPath, RegisterNamespacesInScope)
+{
+    const auto doc = cpplibxml2::Doc::parseFile(nsExampleFile);
+    ASSERT_TRUE(doc);
+    auto context = cpplibxml2::XPathContext::create(doc.value());
+    ASSERT_TRUE(context);
+    ASSERT_TRUE(context.value().registerNamespaces(doc.value().root().value()));
+
+    const auto mandatory = context.value().evaluate("string(/ns2:ConnectorServices/ns2:TLSMandatory)");
+    ASSERT_TRUE(mandatory);
+    EXPECT_EQ(mandatory.value().string(), "true");
+}
+
+TEST(XPath, DocQuery)
+{
+    const auto doc = cpplibxml2::Doc::parseFile(nsExampleFile);
+    ASSERT_TRUE(doc);
+
+    // Root namespace declarations are registered for Doc::query.
+    for (int i = 0; i < 3; ++i)
+    {
+        const auto services = doc.value().query("//ns3:Service/@Name");
+        ASSERT_TRUE(services);
+        ASSERT_FALSE(services.value().empty());
+        EXPECT_EQ(services.value().begin().operator*().type(), cpplibxml2::NodeType::Attribute);
+    }
+
+    const auto root = doc.value().root();
+    ASSERT_TRUE(root);
+    const auto relative = doc.value().query("count(ns2:TLSMandatory)", root.value());
+    ASSERT_TRUE(relative);
+    EXPECT_DOUBLE_EQ(relative.value().number(), 1.0);
+
+    EXPECT_FALSE(doc.value().query("//["));
+}
+
+TEST(XPath, NamespaceNodesAreSkipped)
+{
+    const auto doc = cpplibxml2::Doc::parseFile(nsExampleFile);
+    ASSERT_TRUE(doc);
+
+    const auto namespaces = doc.value().query("/*/namespace::*");
+    ASSERT_TRUE(namespaces);
+    EXPECT_EQ(namespaces.value().type(), cpplibxml2::XPathResultType::NodeSet);
+    EXPECT_TRUE(namespaces.value().empty());
+    EXPECT_EQ(namespaces.value().begin(), namespaces.value().end());
+    EXPECT_TRUE(namespaces.value().boolean());
+
+    // Mixed with nodes, only the nodes are returned.
+    const auto mixed = doc.value().query("/* | /*/namespace::*");
+    ASSERT_TRUE(mixed);
+    ASSERT_EQ(mixed.value().size(), 1u);
+    EXPECT_EQ((*mixed.value().begin()).name().value(), "ConnectorServices");
+}
+
+TEST(XPath, NonElementResults)
+{
+    const auto doc = cpplibxml2::Doc::parseFile(exampleFile);
+    ASSERT_TRUE(doc);
+
+    // Attribute and document nodes have no attributes or namespace of their own to read.
+    const auto ids = doc.value().query("//book/@id");
+    ASSERT_TRUE(ids);
+    const auto id = *ids.value().begin();
+    EXPECT_EQ(id.type(), cpplibxml2::NodeType::Attribute);
+    EXPECT_EQ(id.name().value(), "id");
+    EXPECT_EQ(id.value().value(), "bk101");
+    EXPECT_FALSE(id.attribute("id"));
+    EXPECT_FALSE(id.findProperty("id"));
+    EXPECT_TRUE(id.getProperties().empty());
+    EXPECT_FALSE(id.findChild("id"));
+
+    const auto root = doc.value().query("/");
+    ASSERT_TRUE(root);
+    const auto document = *root.value().begin();
+    EXPECT_EQ(document.name().value(), "");
+    EXPECT_FALSE(document.attribute("id"));
+    EXPECT_TRUE(document.getProperties().empty());
+    EXPECT_EQ(document.getNamespace(), (std::pair<std::string_view, std::string_view>{}));
+    EXPECT_EQ(document.findChild("catalog").value().name().value(), "catalog");
+}
+
+TEST(XPath, DocQueryManyExpressions)
+{
+    const auto doc = cpplibxml2::Doc::parseFile(exampleFile);
+    ASSERT_TRUE(doc);
+
+    // More distinct expressions than the cache keeps, with a repeated one that stays cached and ones evicted earlier.
+    for (int round = 0; round < 2; ++round)
+    {
+        for (int i = 0; i < 300; ++i)
+        {
+            const auto id = "bk" + std::to_string(101 + i % 20);
+            const auto expression = "count(//book[@id='" + id + "']) + " + std::to_string(i);
+            const auto count = doc.value().query(expression);
+            ASSERT_TRUE(count);
+            EXPECT_DOUBLE_EQ(count.value().number(), (i % 20 < 12 ? 1.0 : 0.0) + i);
+
+            const auto books = doc.value().query("count(//book)");
+            ASSERT_TRUE(books);
+            EXPECT_DOUBLE_EQ(books.value().number(), 12.0);
+        }
+    }
+}
+
+TEST(XPath, ResultIsARange)
+{
+    const auto doc = cpplibxml2::Doc::parseFile(exampleFile);
+    ASSERT_TRUE(doc);
+    const auto books = doc.value().query("//book");
+    ASSERT_TRUE(books);
+    static_assert(std::ranges::forward_range<const cpplibxml2::XPathResult &>);
+    EXPECT_EQ(std::ranges::distance(books.value()), 12);
+    EXPECT_EQ(std::ranges::count_if(books.value(),
+                                    [](const cpplibxml2::Node book) {
+                                        return book.findChild("genre").value().value().value() == "Fantasy";
+                                    }),
+              4);
+}